@@ -8,6 +8,8 @@ meta:
 common:
 	ADDON_DEFINES =
 	ADDON_CFLAGS = -O3 -Wno-strict-aliasing
+	# zlib compresses the trajectory recordings
+	ADDON_LDFLAGS = -lz
 
 	# Exclude includes and source.
 	ADDON_SOURCES_EXCLUDE = libs/developableflow/include/%
@@ -182,10 +182,12 @@ void predrawcallback(){
         t.post_step_processing();
         
         //Do postprocessing
+        bool structuralChange = false;
         if(remeshingEnabled) {
             int change = mesh_postprocessing(Developables::m.V, Developables::m.F, Developables::m.E, Developables::m.edgesC, Developables::m.TT, Developables::m.TTi, Developables::m.VF, false);
             if(change==1) { //Structural change happened
                 std::cout << "A structural change happened to the mesh." << std::endl;
+                structuralChange = true;
                 m.origF = m.F;
                 Developables::OVectorXi _1;
                 igl::remove_unreferenced(Developables::OMatrixXs(Developables::m.V), OMatrixXi(m.F), Developables::m.V, Developables::m.F, _1);
@@ -194,9 +196,27 @@ void predrawcallback(){
                 t.invalidate();
                 meshChanged = true;
             }
+            
+            //Every few steps remesh isotropically, so the triangles stay well shaped and the line search can take large steps
+            if(remeshInterval > 0 && t.totalSteps % remeshInterval == 0) {
+                change = isotropic_remeshing(Developables::m.V, Developables::m.F, Developables::m.origV, remeshTargetEdgeLength);
+                if(change==1) { //Structural change happened
+                    structuralChange = true;
+                    m.origF = m.F;
+                    Developables::m.update();
+                    t.invalidate();
+                    meshChanged = true;
+                } else {
+                    //The vertices were relaxed, the cache is stale but the timestep still fits
+                    t.invalidate_cache();
+                }
+            }
         }
         meshPosChanged = true;
         
+        //Record the step, does nothing unless the trajectory was opened
+        trajectory.record(m.V, m.F, structuralChange);
+        
         //Update labels
 //        double totalEnergy = toDouble(t.energy.sum());
 //        lines[0].conservativeResize(lines[0].size()+1);
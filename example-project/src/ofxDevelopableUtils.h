@@ -11,6 +11,10 @@
 #include "Types.h"
 #include "Mesh.h"
 #include "ofxDevelopableViewer.h"
+#include <tools/trajectory.h>
+#include <developableflow/isotropic_remeshing.h>
+
+#define REMESH_INTERVAL 10 //Flow steps between two isotropic remeshings, 0 for never
 
 namespace Developables{
     struct Timestep {
@@ -27,11 +31,16 @@ namespace Developables{
             ++totalSteps;
         }
         
-        void invalidate()
+        void invalidate_cache() //Drops the cached energy, grad and search direction, keeps the timestep
         {
             energy = OVectorXs();
             energyGrad = OMatrixXs();
             p = OMatrixXs();
+        }
+        
+        void invalidate()
+        {
+            invalidate_cache();
             t = 1e-8;
         }
     };
@@ -44,6 +53,9 @@ namespace Developables{
     Developables::Mesh m;
     ofxDevelopableViewer viewer;
     Timestep t;
+    TrajectoryRecorder trajectory; //open() to record every step of the flow to a .dtraj file
+    int remeshInterval = REMESH_INTERVAL; //Isotropic remeshing every this many flow steps while remeshing is enabled, 0 for never
+    Scalar remeshTargetEdgeLength = 0; //Target edge length of the remeshing, 0 for the current average edge length
   
   
 
@@ -27,25 +27,30 @@
 
 #include <developableflow/hinge_energy.h>
 #include <developableflow/hingepairs_energy.h>
+#include <developableflow/cut_graph.h>
+#include <developableflow/cut_wedges.h>
+#include <tools/thread_pool.h>
 
 #include <vector>
 #include <list>
 #include <set>
+#include <map>
+#include <algorithm>
 #include <utility>
 
 
 #define INFTY std::numeric_limits<double>::infinity()
 
 
-template <typename derivedV, typename derivedE, typename indexType, typename derivedCut>
+template <typename derivedV, typename derivedF, typename derivedTTi, typename derivedE, typename derivedEMAP, typename indexType, typename cornerType, typename derivedCut>
 IGL_INLINE int compute_cut_erickson(const Eigen::PlainObjectBase<derivedV>& V,
-                                    const Eigen::PlainObjectBase<derivedE>& F,
+                                    const Eigen::PlainObjectBase<derivedF>& F,
                                     const Eigen::PlainObjectBase<derivedE>& E,
-                                    const Eigen::PlainObjectBase<derivedE>& edgesC,
-                                    const Eigen::PlainObjectBase<derivedE>& TT,
-                                    const Eigen::PlainObjectBase<derivedE>& TTi,
+                                    const Eigen::PlainObjectBase<derivedEMAP>& edgesC,
+                                    const Eigen::PlainObjectBase<derivedF>& TT,
+                                    const Eigen::PlainObjectBase<derivedTTi>& TTi,
                                     const std::vector<std::vector<indexType> >& VF,
-                                    const std::vector<std::vector<indexType> >& VFi,
+                                    const std::vector<std::vector<cornerType> >& VFi,
                                     const std::vector<bool>& isB,
                                     Eigen::PlainObjectBase<derivedCut>& cut)
 {
@@ -53,21 +58,21 @@ IGL_INLINE int compute_cut_erickson(const Eigen::PlainObjectBase<derivedV>& V,
 }
 
 
-template <typename derivedV, typename derivedE, typename derivedCostScalar, typename indexType, typename derivedCut>
+template <typename derivedV, typename derivedF, typename derivedTTi, typename derivedE, typename derivedEMAP, typename derivedCostScalar, typename indexType, typename cornerType, typename derivedCut>
 IGL_INLINE int compute_cut_erickson(const Eigen::PlainObjectBase<derivedV>& V,
-                                    const Eigen::PlainObjectBase<derivedE>& F,
+                                    const Eigen::PlainObjectBase<derivedF>& F,
                                     const Eigen::PlainObjectBase<derivedE>& E,
-                                    const Eigen::PlainObjectBase<derivedE>& edgesC,
-                                    const Eigen::PlainObjectBase<derivedE>& TT,
-                                    const Eigen::PlainObjectBase<derivedE>& TTi,
+                                    const Eigen::PlainObjectBase<derivedEMAP>& edgesC,
+                                    const Eigen::PlainObjectBase<derivedF>& TT,
+                                    const Eigen::PlainObjectBase<derivedTTi>& TTi,
                                     const std::vector<std::vector<indexType> >& VF,
-                                    const std::vector<std::vector<indexType> >& VFi,
+                                    const std::vector<std::vector<cornerType> >& VFi,
                                     const std::vector<bool>& isB,
                                     const derivedCostScalar& costThreshold,
                                     Eigen::PlainObjectBase<derivedCut>& cut)
 {
     typedef typename derivedV::Scalar t_V_s;
-    typedef Eigen::Matrix<t_V_s, Eigen::Dynamic, 3> t_V;
+    typedef Eigen::Matrix<t_V_s, Eigen::Dynamic, 3, (derivedV::IsRowMajor ? Eigen::RowMajor : Eigen::ColMajor)> t_V;
     typedef Eigen::Matrix<t_V_s, Eigen::Dynamic, 1> t_Vv;
     typedef typename derivedE::Scalar t_E_i;
     
@@ -86,26 +91,26 @@ IGL_INLINE int compute_cut_erickson(const Eigen::PlainObjectBase<derivedV>& V,
 }
 
 
-template <typename derivedV, typename derivedE, typename indexType, typename derivedCut>
+template <typename derivedV, typename derivedF, typename derivedTTi, typename derivedE, typename derivedEMAP, typename indexType, typename cornerType, typename derivedCut>
 IGL_INLINE int compute_cut_erickson(const Eigen::PlainObjectBase<derivedV>& V,
-                                    const Eigen::PlainObjectBase<derivedE>& F,
+                                    const Eigen::PlainObjectBase<derivedF>& F,
                                     const Eigen::PlainObjectBase<derivedE>& E,
-                                    const Eigen::PlainObjectBase<derivedE>& edgesC,
-                                    const Eigen::PlainObjectBase<derivedE>& TT,
-                                    const Eigen::PlainObjectBase<derivedE>& TTi,
+                                    const Eigen::PlainObjectBase<derivedEMAP>& edgesC,
+                                    const Eigen::PlainObjectBase<derivedF>& TT,
+                                    const Eigen::PlainObjectBase<derivedTTi>& TTi,
                                     const std::vector<std::vector<indexType> >& VF,
-                                    const std::vector<std::vector<indexType> >& VFi,
+                                    const std::vector<std::vector<cornerType> >& VFi,
                                     const std::vector<bool>& isB,
                                     const std::vector<typename derivedE::Scalar>& punctureList,
                                     Eigen::PlainObjectBase<derivedCut>& cut)
 {
     typedef typename derivedV::Scalar t_V_s;
-    typedef Eigen::Matrix<t_V_s, Eigen::Dynamic, 3> t_V;
+    typedef Eigen::Matrix<t_V_s, Eigen::Dynamic, 3, (derivedV::IsRowMajor ? Eigen::RowMajor : Eigen::ColMajor)> t_V;
     typedef Eigen::Matrix<t_V_s, 3, 1> t_V3;
     typedef Eigen::Matrix<t_V_s, Eigen::Dynamic, 1> t_Vv;
     typedef typename derivedE::Scalar t_E_i;
-    typedef Eigen::Matrix<t_E_i, Eigen::Dynamic, 2> t_E;
-    typedef Eigen::Matrix<t_E_i, Eigen::Dynamic, 3> t_F;
+    typedef Eigen::Matrix<t_E_i, Eigen::Dynamic, 2, (derivedE::IsRowMajor ? Eigen::RowMajor : Eigen::ColMajor)> t_E;
+    typedef Eigen::Matrix<t_E_i, Eigen::Dynamic, 3, (derivedF::IsRowMajor ? Eigen::RowMajor : Eigen::ColMajor)> t_F;
     typedef Eigen::Matrix<t_E_i, Eigen::Dynamic, 1> t_Fv;
     typedef Eigen::Matrix<bool, Eigen::Dynamic, 1> t_Ebool;
     typedef typename derivedCut::Scalar t_cut_i;
@@ -123,152 +128,79 @@ IGL_INLINE int compute_cut_erickson(const Eigen::PlainObjectBase<derivedV>& V,
     const t_E_i npunctures = punctureList.size();
     
     
-    //Halfedge data structure
-    struct Halfedge {
-        t_E_i face;
-        t_E_i j;
-        t_E_i normalj() const {return (j+2)%3;}
-        Halfedge(const t_E_i& i_f, const t_E_i& i_j) : face(i_f), j(i_j) {}
-        Halfedge() {}
-        Halfedge next() const {return Halfedge(face, (j+1)%3);}
-        bool operator==(const Halfedge& he) const {return face==he.face && j==he.j;}
-    };
-    typedef std::vector<Halfedge> Halfedges;
-    const auto heedge = [&F, &edgesC](const Halfedge& he) {
-        return edgesC(he.face + F.rows()*he.normalj());
-    };
-    const auto hetail = [&F](const Halfedge& he) {
-        return F(he.face, he.j);
-    };
-    const auto hehead = [&F](const Halfedge& he) {
-        return F(he.face, (he.j+1)%3);
-    };
-    const auto heflip = [&TT, &TTi](const Halfedge& he) {
-        return Halfedge(TT(he.face,he.j), TTi(he.face,he.j));
-    };
-    const auto hesatvert = [&VF, &VFi](const t_E_i& vert) {
-        const std::vector<indexType>& adjFaces = VF[vert];
-        const std::vector<indexType>& adjFacesi = VFi[vert];
-        Halfedges halfedges(adjFaces.size());
-        for(int i=0; i<halfedges.size(); ++i)
-            halfedges[i] = Halfedge(adjFaces[i], adjFacesi[i]);
-        return halfedges;
-    };
-    const auto hecost = [&isB, &hehead, &hetail, &minCurvatureVecs, &V](const Halfedge& he) {
-        const t_E_i& v = hetail(he);
-        const t_E_i& w = hehead(he);
-        if(isB[v] && isB[w])
-            return INFTY;
-        t_V3 edgevec = V.row(w) - V.row(v);
-        const t_V_s enorm = edgevec.norm(); edgevec /= enorm;
-        return minCurvatureVecs.row(v).cross(edgevec).norm() + enorm;
-        //return enorm;
-    };
-    const auto sharpness = [&hecost](const Halfedges& string) {
-        t_V_s sharp = 0.;
-        for(int i=0; i<string.size(); ++i)
-            sharp += hecost(string[i]);
-        return sharp;
-    };
-
+    //Halfedge graph with precomputed costs
+    CutGraph<t_V_s, t_E_i> graph;
+    build_cut_graph(V, F, edgesC, isB, minCurvatureVecs, graph);
+    
+    std::vector<t_E_i> punctureIds(V.rows(), -1);
+    for(int i=0; i<npunctures; ++i)
+        punctureIds[punctureList[i]] = i;
+    
     
     //Build adjacency matrix for puncture list. Cost of each edge is determined by dijkstra's shortest path
-    std::vector<std::vector<Halfedges> > adjacency(npunctures);
-    for(int puncture1=0; puncture1<npunctures; ++puncture1) {
-        const t_E_i& p1ind = punctureList[puncture1];
-        std::vector<Halfedges>& localAdjacency = adjacency[puncture1];
-        std::vector<bool> localPsVisited(npunctures);
-        for(int i=0; i<npunctures; ++i)
-            localPsVisited[i] = false;
-        
-        //Use Dijkstra to find the shortest path from puncture1 to the localPs. Based on libigl's dijkstra.h
-        t_Vv minDistance = t_Vv::Constant(V.rows(), INFTY);
-        minDistance(p1ind) = 0.;
-        t_Fv prev = t_Fv::Constant(V.rows(), -1);
-        std::set<std::pair<t_V_s, t_E_i> > vertexQueue;
-        vertexQueue.insert(std::make_pair(minDistance(p1ind), p1ind));
+    std::vector<std::vector<std::vector<t_E_i> > > adjacency(npunctures);
+    Eigen::Matrix<t_V_s, Eigen::Dynamic, Eigen::Dynamic> pairDistances = Eigen::Matrix<t_V_s, Eigen::Dynamic, Eigen::Dynamic>::Constant(npunctures, npunctures, INFTY);
+    std::vector<CutDijkstra<t_V_s, t_E_i> > dijkstras; //one per thread, the scratch arrays are reused between punctures
+    const auto prep_dijkstras = [&dijkstras, &graph] (const int& threadNum) {
+        dijkstras.clear();
+        dijkstras.reserve(threadNum);
+        for(int t=0; t<threadNum; ++t)
+            dijkstras.emplace_back(graph);
+    };
+    const auto handle_puncture = [&] (const int& puncture1, const int& thread) {
+        CutDijkstra<t_V_s, t_E_i>& dijkstra = dijkstras[thread];
         
-        while(!vertexQueue.empty()) {
-            const t_V_s dist = vertexQueue.begin()->first;
-            const t_E_i u = vertexQueue.begin()->second;
-            vertexQueue.erase(vertexQueue.begin());
-            
-            bool allPsVisited = true;
-            for(int i=0; i<npunctures; ++i) {
-                if(punctureList[i]==u)
-                    localPsVisited[i] = true;
-                if(!localPsVisited[i]) {
-                    allPsVisited = false;
-                    break;
-                }
-            }
-            if(allPsVisited)
-                break;
-            
-            //Visit each halfedge exiting u
-            for(Halfedge he : hesatvert(u)) {
-                const t_E_i& v = hehead(he);
-                const t_V_s distThroughU = dist + hecost(he);
-                if(distThroughU < minDistance(v)) {
-                    vertexQueue.erase(std::make_pair(minDistance(v), v));
-                    minDistance(v) = distThroughU;
-                    prev(v) = u;
-                    vertexQueue.insert(std::make_pair(minDistance(v), v));
-                }
-            }
-        }
+        //Stop as soon as all punctures are settled
+        dijkstra.run(punctureList[puncture1], punctureIds, npunctures);
         
         //Build the local adjacency list
-        localAdjacency = std::vector<Halfedges>(npunctures);
+        std::vector<std::vector<t_E_i> >& localAdjacency = adjacency[puncture1];
+        localAdjacency.resize(npunctures);
         for(int target=0; target<npunctures; ++target) {
             if(puncture1 == target)
                 continue;
-            
-            Halfedges reversePath;
-            t_E_i currentVert = punctureList[target];
-            while(currentVert != p1ind) {
-                t_E_i nextVert = prev(currentVert);
-                for(Halfedge he : hesatvert(nextVert)) {
-                    if(hehead(he) == currentVert) {
-                        reversePath.push_back(he);
-                        break;
-                    }
-                }
-                currentVert = nextVert;
-            }
-            localAdjacency[target] = Halfedges(reversePath.rbegin(), reversePath.rend());
+            pairDistances(puncture1, target) = dijkstra.distance(punctureList[target]);
+            dijkstra.path_edges(punctureList[target], localAdjacency[target]);
         }
-    }
+    };
+    
+#ifndef PARALLEL_COMPUTATION
+    //SERIAL VERSION
+    prep_dijkstras(1);
+    for(int puncture1=0; puncture1<npunctures; ++puncture1)
+        handle_puncture(puncture1, 0);
+#else
+    //PARALLEL VERSION, every puncture is a full Dijkstra so even a handful is worth spreading out
+    solver_parallel_for(npunctures, prep_dijkstras, handle_puncture, [] (const int&) {}, 2);
+#endif
     
-    //Using the adjacency matrix from earlier, compute a minimum spanning tree. Uses Prim's algorithm (Wikipedia)
+    //Using the adjacency matrix from earlier, compute a minimum spanning tree. Uses Prim's algorithm on the dense puncture graph,
+    //the weight of a pair is the length of its shortest path
     std::set<t_E_i> cutEdges;
     t_Vv pC = t_Vv::Constant(npunctures, INFTY);
     t_Fv pE = t_Fv::Constant(npunctures, -1);
-    std::set<std::pair<t_V_s, t_E_i> > pQ;
-    for(int i=0; i<npunctures; ++i)
-        pQ.insert(std::make_pair(pC(i), i));
+    std::vector<bool> inTree(npunctures, false);
     
-    while(!pQ.empty()) {
-        const t_E_i v = pQ.begin()->second;
-        pQ.erase(pQ.begin());
+    for(int iter=0; iter<npunctures; ++iter) {
+        t_E_i v = -1;
+        for(int w=0; w<npunctures; ++w)
+            if(!inTree[w] && (v==-1 || pC(w) < pC(v)))
+                v = w;
+        inTree[v] = true;
         
         if(pE(v) != -1) {
             //This edge will be included in the final cut. Mark these edges.
-            for(Halfedge h : adjacency[pE(v)][v])
-                cutEdges.insert(heedge(h));
+            for(const t_E_i& edge : adjacency[pE(v)][v])
+                cutEdges.insert(edge);
         }
         
         for(int w=0; w<npunctures; ++w) {
-            if(v==w)
+            if(inTree[w])
                 continue;
-            if(pQ.find(std::make_pair(pC(w), w)) != pQ.end()) {
-                const t_V_s weight = sharpness(adjacency[v][w]);
-                if(weight < pC(w)) {
-                    pQ.erase(std::make_pair(pC(w), w));
-                    pC(w) = weight;
-                    pE(w) = v;
-                    pQ.insert(std::make_pair(pC(w), w));
-                }
+            const t_V_s& weight = pairDistances(v, w);
+            if(weight < pC(w)) {
+                pC(w) = weight;
+                pE(w) = v;
             }
         }
     }
@@ -283,6 +215,118 @@ IGL_INLINE int compute_cut_erickson(const Eigen::PlainObjectBase<derivedV>& V,
 }
 
 
+template <typename derivedV, typename derivedF, typename derivedTTi, typename derivedE, typename derivedEMAP, typename indexType, typename cornerType, typename derivedCut>
+IGL_INLINE int compute_cut_voronoi(const Eigen::PlainObjectBase<derivedV>& V,
+                                   const Eigen::PlainObjectBase<derivedF>& F,
+                                   const Eigen::PlainObjectBase<derivedE>& E,
+                                   const Eigen::PlainObjectBase<derivedEMAP>& edgesC,
+                                   const Eigen::PlainObjectBase<derivedF>& TT,
+                                   const Eigen::PlainObjectBase<derivedTTi>& TTi,
+                                   const std::vector<std::vector<indexType> >& VF,
+                                   const std::vector<std::vector<cornerType> >& VFi,
+                                   const std::vector<bool>& isB,
+                                   const std::vector<typename derivedE::Scalar>& punctureList,
+                                   Eigen::PlainObjectBase<derivedCut>& cut)
+{
+    typedef typename derivedV::Scalar t_V_s;
+    typedef Eigen::Matrix<t_V_s, Eigen::Dynamic, 3, (derivedV::IsRowMajor ? Eigen::RowMajor : Eigen::ColMajor)> t_V;
+    typedef Eigen::Matrix<t_V_s, Eigen::Dynamic, 1> t_Vv;
+    typedef typename derivedE::Scalar t_E_i;
+    typedef typename derivedCut::Scalar t_cut_i;
+    typedef Eigen::Matrix<t_cut_i, Eigen::Dynamic, 1> t_cut;
+    
+    int retVal = 0;
+    
+    
+    //Compute the hinge energy for the min curvature vecs
+    t_Vv hingeEnergy;
+    t_V minCurvatureVecs;
+    hinge_energy(V, F, VF, VFi, isB, hingeEnergy, minCurvatureVecs);
+    
+    //Constants
+    const t_E_i npunctures = punctureList.size();
+    
+    
+    //Halfedge graph with precomputed costs
+    CutGraph<t_V_s, t_E_i> graph;
+    build_cut_graph(V, F, edgesC, isB, minCurvatureVecs, graph);
+    
+    //Geodesic Voronoi diagram of the punctures
+    CutDijkstra<t_V_s, t_E_i> dijkstra(graph);
+    dijkstra.run_voronoi(punctureList);
+    
+    //Every halfedge between two Voronoi cells is a candidate path between their punctures.
+    //Only keep the cheapest one per pair of punctures.
+    struct Candidate {
+        t_V_s length;
+        t_E_i p1, p2;
+        t_E_i halfedge;
+        bool operator<(const Candidate& c) const {return length < c.length;}
+    };
+    std::map<std::pair<t_E_i, t_E_i>, Candidate> bestCandidates;
+    for(t_E_i u=0; u<graph.n_vertices(); ++u) {
+        const t_E_i& pu = dijkstra.nearest_source(u);
+        if(pu < 0)
+            continue;
+        for(t_E_i h=graph.offsets[u]; h<graph.offsets[u+1]; ++h) {
+            const t_E_i& w = graph.heads[h];
+            const t_E_i& pw = dijkstra.nearest_source(w);
+            if(pw < 0 || pw == pu)
+                continue;
+            const t_V_s length = dijkstra.distance(u) + graph.costs[h] + dijkstra.distance(w);
+            if(length == INFTY)
+                continue;
+            const std::pair<t_E_i, t_E_i> key = std::make_pair(std::min(pu, pw), std::max(pu, pw));
+            auto iter = bestCandidates.find(key);
+            if(iter == bestCandidates.end() || length < iter->second.length)
+                bestCandidates[key] = Candidate{length, u, w, h};
+        }
+    }
+    std::vector<Candidate> candidates;
+    candidates.reserve(bestCandidates.size());
+    for(const auto& c : bestCandidates)
+        candidates.push_back(c.second);
+    std::sort(candidates.begin(), candidates.end());
+    
+    //Kruskal on the candidate graph. Union-find with path halving over the punctures
+    std::vector<t_E_i> parent(npunctures);
+    for(int i=0; i<npunctures; ++i)
+        parent[i] = i;
+    const auto find_root = [&parent] (t_E_i p) {
+        while(parent[p] != p) {
+            parent[p] = parent[parent[p]];
+            p = parent[p];
+        }
+        return p;
+    };
+    
+    std::set<t_E_i> cutEdges;
+    std::vector<t_E_i> pathEdges;
+    for(const Candidate& c : candidates) {
+        const t_E_i r1 = find_root(dijkstra.nearest_source(c.p1));
+        const t_E_i r2 = find_root(dijkstra.nearest_source(c.p2));
+        if(r1 == r2)
+            continue;
+        parent[r1] = r2;
+        
+        //This path will be included in the final cut: both halves back to their punctures, plus the edge between the cells
+        pathEdges.clear();
+        dijkstra.path_edges(c.p1, pathEdges);
+        dijkstra.path_edges(c.p2, pathEdges);
+        pathEdges.push_back(graph.edges[c.halfedge]);
+        cutEdges.insert(pathEdges.begin(), pathEdges.end());
+    }
+    
+    cut = t_cut(cutEdges.size());
+    int ind = 0;
+    for(t_E_i edge : cutEdges)
+        cut(ind++) = edge;
+    
+    
+    return retVal;
+}
+
+
 /*#include <igl/copyleft/cgal/extract_feature.h>
 #include <CGAL/Exact_predicates_inexact_constructions_kernel.h>
 #include <CGAL/boost/graph/graph_traits_Polyhedron_3.h>
@@ -301,9 +345,9 @@ IGL_INLINE int compute_cut_cgal(const Eigen::PlainObjectBase<derivedV>& V,
                                 Eigen::PlainObjectBase<derivedSegmentIDs>& segmentIds)
 {
     typedef typename derivedV::Scalar t_V_s;
-    typedef Eigen::Matrix<t_V_s, Eigen::Dynamic, 3> t_V;
+    typedef Eigen::Matrix<t_V_s, Eigen::Dynamic, 3, (derivedV::IsRowMajor ? Eigen::RowMajor : Eigen::ColMajor)> t_V;
     typedef typename derivedF::Scalar t_F_i;
-    typedef Eigen::Matrix<t_F_i, Eigen::Dynamic, 3> t_F;
+    typedef Eigen::Matrix<t_F_i, Eigen::Dynamic, 3, (derivedF::IsRowMajor ? Eigen::RowMajor : Eigen::ColMajor)> t_F;
     typedef typename derivedCost::Scalar t_cost_s;
     typedef Eigen::Matrix<t_cost_s, Eigen::Dynamic, 1> t_cost;
     typedef typename derivedSegmentIDs::Scalar t_segmentid_i;
@@ -355,109 +399,24 @@ IGL_INLINE int compute_cut_cgal(const Eigen::PlainObjectBase<derivedV>& V,
 
 
 
-template <typename derivedV, typename derivedE, typename indexType, typename derivedCut, typename derivedRetV, typename derivedRetE>
+template <typename derivedV, typename derivedF, typename derivedTTi, typename derivedE, typename derivedEMAP, typename indexType, typename cornerType, typename derivedCut, typename derivedRetV, typename derivedRetE>
 IGL_INLINE void cut_mesh(const Eigen::PlainObjectBase<derivedV>& V,
-                        const Eigen::PlainObjectBase<derivedE>& F,
+                        const Eigen::PlainObjectBase<derivedF>& F,
                         const Eigen::PlainObjectBase<derivedE>& E,
-                        const Eigen::PlainObjectBase<derivedE>& edgesC,
-                        const Eigen::PlainObjectBase<derivedE>& TT,
-                        const Eigen::PlainObjectBase<derivedE>& TTi,
+                        const Eigen::PlainObjectBase<derivedEMAP>& edgesC,
+                        const Eigen::PlainObjectBase<derivedF>& TT,
+                        const Eigen::PlainObjectBase<derivedTTi>& TTi,
                         const std::vector<std::vector<indexType> >& VF,
-                        const std::vector<std::vector<indexType> >& VFi,
+                        const std::vector<std::vector<cornerType> >& VFi,
                         const std::vector<bool>& isB,
                         const Eigen::PlainObjectBase<derivedCut>& cut,
                         Eigen::PlainObjectBase<derivedRetV>& retV,
                         Eigen::PlainObjectBase<derivedRetE>& retF)
 {
-    typedef typename derivedV::Scalar t_V_s;
-    typedef Eigen::Matrix<t_V_s, Eigen::Dynamic, 3> t_V;
-    typedef Eigen::Matrix<t_V_s, 3, 1> t_V3;
-    typedef Eigen::Matrix<t_V_s, Eigen::Dynamic, 1> t_Vv;
-    typedef typename derivedE::Scalar t_E_i;
-    typedef Eigen::Matrix<t_E_i, Eigen::Dynamic, 2> t_E;
-    typedef Eigen::Matrix<t_E_i, Eigen::Dynamic, 3> t_F;
-    typedef Eigen::Matrix<t_E_i, Eigen::Dynamic, 1> t_Fv;
-    typedef Eigen::Matrix<bool, Eigen::Dynamic, 1> t_Ebool;
-    typedef typename derivedCut::Scalar t_cut_i;
-    typedef Eigen::Matrix<t_cut_i, Eigen::Dynamic, 1> t_cut;
-    typedef typename derivedRetV::Scalar t_retV_s;
-    typedef Eigen::Matrix<t_retV_s, Eigen::Dynamic, 3> t_retV;
     typedef typename derivedRetE::Scalar t_retE_i;
-    typedef Eigen::Matrix<t_retE_i, Eigen::Dynamic, 3> t_retF;
-    
-    
-    //Halfedge data structure
-    struct Halfedge {
-        t_E_i face;
-        t_E_i j;
-        t_E_i normalj() const {return (j+2)%3;}
-        Halfedge(const t_E_i& i_f, const t_E_i& i_j) : face(i_f), j(i_j) {}
-        Halfedge() {}
-        Halfedge next() const {return Halfedge(face, (j+1)%3);}
-        bool operator==(const Halfedge& he) const {return face==he.face && j==he.j;}
-        bool operator!=(const Halfedge& he) const {return face!=he.face || j!=he.j;}
-    };
-    typedef std::vector<Halfedge> Halfedges;
-    const auto heedge = [&F, &edgesC](const Halfedge& he) {
-        return edgesC(he.face + F.rows()*he.normalj());
-    };
-    const auto hetail = [&F](const Halfedge& he) {
-        return F(he.face, he.j);
-    };
-    const auto hehead = [&F](const Halfedge& he) {
-        return F(he.face, (he.j+1)%3);
-    };
-    const auto heflip = [&TT, &TTi](const Halfedge& he) {
-        return Halfedge(TT(he.face,he.j), TTi(he.face,he.j));
-    };
-    const auto hesatvert = [&VF, &VFi](const t_E_i& vert) {
-        const std::vector<indexType>& adjFaces = VF[vert];
-        const std::vector<indexType>& adjFacesi = VFi[vert];
-        Halfedges halfedges(adjFaces.size());
-        for(int i=0; i<halfedges.size(); ++i)
-            halfedges[i] = Halfedge(adjFaces[i], adjFacesi[i]);
-        return halfedges;
-    };
-    
-    
-    //Compute an edge cut bool
-    t_Ebool cutBool = t_Ebool::Constant(E.rows(), false);
-    for(int i=0; i<cut.size(); ++i)
-        cutBool(cut(i)) = true;
-    
-    std::vector<bool> bdryOrCut = isB;
-    //Assign cut dofs
-    retF.resize(F.rows(), 3);
-    int nDof = 0;
-    for(int vert=0; vert<V.rows(); ++vert) {
-        Halfedges hesAtVert = hesatvert(vert);
-        
-        //Find a cut edge if it exists
-        Halfedge he = hesAtVert[0];
-        for(Halfedge h : hesAtVert) {
-            if(cutBool(heedge(h))) {
-                he = h;
-                bdryOrCut[vert] = true;
-                break;
-            }
-        }
-        
-        //Walk back one
-        he = heflip(he).next();
-        Halfedge h = he;
-        do {
-            retF(h.face, h.j) = nDof;
-            if(cutBool(heedge(h)) && heflip(h).next()!=he)
-                ++nDof;
-            h = heflip(h).next();
-        } while(h != he);
-        ++nDof;
-    }
-    
-    retV.resize(nDof, 3);
-    for(int face=0; face<F.rows(); ++face)
-        for(int j=0; j<3; ++j)
-            retV.row(retF(face,j)) = V.row(F(face,j));
+    typedef Eigen::Matrix<t_retE_i, Eigen::Dynamic, 1> t_wedgeMap;
     
-            
+    //One dof per fan of faces between cut (or boundary) edges
+    t_wedgeMap wedgeToVertex;
+    cut_wedges(V, F, edgesC, TT, TTi, VF, VFi, cut, retV, retF, wedgeToVertex);
 }
@@ -32,44 +32,59 @@
 //Returns 0 on success, error code otherwise
 
 //Dynamic thresholding, there is no predetermined threshold
-template <typename derivedV, typename derivedE, typename indexType, typename derivedCut>
+template <typename derivedV, typename derivedF, typename derivedTTi, typename derivedE, typename derivedEMAP, typename indexType, typename cornerType, typename derivedCut>
 IGL_INLINE int compute_cut_erickson(const Eigen::PlainObjectBase<derivedV>& V, //Vertices
-                                    const Eigen::PlainObjectBase<derivedE>& F, //Faces
+                                    const Eigen::PlainObjectBase<derivedF>& F, //Faces
                                     const Eigen::PlainObjectBase<derivedE>& E, //Edges
-                                    const Eigen::PlainObjectBase<derivedE>& edgesC, //EMAP
-                                    const Eigen::PlainObjectBase<derivedE>& TT, //TT from triangle_triangle_adjacency
-                                    const Eigen::PlainObjectBase<derivedE>& TTi, //TTi from triangle_triangle_adjacency
+                                    const Eigen::PlainObjectBase<derivedEMAP>& edgesC, //EMAP
+                                    const Eigen::PlainObjectBase<derivedF>& TT, //TT from triangle_triangle_adjacency
+                                    const Eigen::PlainObjectBase<derivedTTi>& TTi, //TTi from triangle_triangle_adjacency
                                     const std::vector<std::vector<indexType> >& VF, //VF from vertex_triangle_adjacency
-                                    const std::vector<std::vector<indexType> >& VFi, //VFi from vertex_triangle_adjacency
+                                    const std::vector<std::vector<cornerType> >& VFi, //VFi from vertex_triangle_adjacency
                                     const std::vector<bool>& isB,//Is a vertex a bdry
                                     Eigen::PlainObjectBase<derivedCut>& cut); //indices to cut edges return val
 
-template <typename derivedV, typename derivedE, typename derivedCostScalar, typename indexType, typename derivedCut>
+template <typename derivedV, typename derivedF, typename derivedTTi, typename derivedE, typename derivedEMAP, typename derivedCostScalar, typename indexType, typename cornerType, typename derivedCut>
 IGL_INLINE int compute_cut_erickson(const Eigen::PlainObjectBase<derivedV>& V, //Vertices
-                                    const Eigen::PlainObjectBase<derivedE>& F, //Faces
+                                    const Eigen::PlainObjectBase<derivedF>& F, //Faces
                                     const Eigen::PlainObjectBase<derivedE>& E, //Edges
-                                    const Eigen::PlainObjectBase<derivedE>& edgesC, //EMAP
-                                    const Eigen::PlainObjectBase<derivedE>& TT, //TT from triangle_triangle_adjacency
-                                    const Eigen::PlainObjectBase<derivedE>& TTi, //TTi from triangle_triangle_adjacency
+                                    const Eigen::PlainObjectBase<derivedEMAP>& edgesC, //EMAP
+                                    const Eigen::PlainObjectBase<derivedF>& TT, //TT from triangle_triangle_adjacency
+                                    const Eigen::PlainObjectBase<derivedTTi>& TTi, //TTi from triangle_triangle_adjacency
                                     const std::vector<std::vector<indexType> >& VF, //VF from vertex_triangle_adjacency
-                                    const std::vector<std::vector<indexType> >& VFi, //VFi from vertex_triangle_adjacency
+                                    const std::vector<std::vector<cornerType> >& VFi, //VFi from vertex_triangle_adjacency
                                     const std::vector<bool>& isB,//Is a vertex a bdry
                                     const derivedCostScalar& costThreshold, //vertices above this absolutely have to be included in the cut
                                     Eigen::PlainObjectBase<derivedCut>& cut); //indices to cut edges return val
 
-template <typename derivedV, typename derivedE, typename indexType, typename derivedCut>
+template <typename derivedV, typename derivedF, typename derivedTTi, typename derivedE, typename derivedEMAP, typename indexType, typename cornerType, typename derivedCut>
 IGL_INLINE int compute_cut_erickson(const Eigen::PlainObjectBase<derivedV>& V, //Vertices
-                                    const Eigen::PlainObjectBase<derivedE>& F, //Faces
+                                    const Eigen::PlainObjectBase<derivedF>& F, //Faces
                                     const Eigen::PlainObjectBase<derivedE>& E, //Edges
-                                    const Eigen::PlainObjectBase<derivedE>& edgesC, //EMAP
-                                    const Eigen::PlainObjectBase<derivedE>& TT, //TT from triangle_triangle_adjacency
-                                    const Eigen::PlainObjectBase<derivedE>& TTi, //TTi from triangle_triangle_adjacency
+                                    const Eigen::PlainObjectBase<derivedEMAP>& edgesC, //EMAP
+                                    const Eigen::PlainObjectBase<derivedF>& TT, //TT from triangle_triangle_adjacency
+                                    const Eigen::PlainObjectBase<derivedTTi>& TTi, //TTi from triangle_triangle_adjacency
                                     const std::vector<std::vector<indexType> >& VF, //VF from vertex_triangle_adjacency
-                                    const std::vector<std::vector<indexType> >& VFi, //VFi from vertex_triangle_adjacency
+                                    const std::vector<std::vector<cornerType> >& VFi, //VFi from vertex_triangle_adjacency
                                     const std::vector<bool>& isB,//Is a vertex a bdry
                                     const std::vector<typename derivedE::Scalar>& punctureList, //A list of the vertices that have to be included in the cuts
                                     Eigen::PlainObjectBase<derivedCut>& cut); //indices to cut edges return val
 
+//Same as above, but connects the punctures with a single multi-source Dijkstra: candidate paths are taken where the geodesic Voronoi cells
+//of two punctures meet, and the cut is the minimum spanning tree of those candidates (2-approximate Steiner tree, Mehlhorn)
+template <typename derivedV, typename derivedF, typename derivedTTi, typename derivedE, typename derivedEMAP, typename indexType, typename cornerType, typename derivedCut>
+IGL_INLINE int compute_cut_voronoi(const Eigen::PlainObjectBase<derivedV>& V, //Vertices
+                                   const Eigen::PlainObjectBase<derivedF>& F, //Faces
+                                   const Eigen::PlainObjectBase<derivedE>& E, //Edges
+                                   const Eigen::PlainObjectBase<derivedEMAP>& edgesC, //EMAP
+                                   const Eigen::PlainObjectBase<derivedF>& TT, //TT from triangle_triangle_adjacency
+                                   const Eigen::PlainObjectBase<derivedTTi>& TTi, //TTi from triangle_triangle_adjacency
+                                   const std::vector<std::vector<indexType> >& VF, //VF from vertex_triangle_adjacency
+                                   const std::vector<std::vector<cornerType> >& VFi, //VFi from vertex_triangle_adjacency
+                                   const std::vector<bool>& isB,//Is a vertex a bdry
+                                   const std::vector<typename derivedE::Scalar>& punctureList, //A list of the vertices that have to be included in the cuts
+                                   Eigen::PlainObjectBase<derivedCut>& cut); //indices to cut edges return val
+
 /*template <typename derivedV, typename derivedF, typename derivedCost, typename derivedCostScalar, typename derivedSegmentIDs>
 IGL_INLINE int compute_cut_cgal(const Eigen::PlainObjectBase<derivedV>& V, //Vertices
                                 const Eigen::PlainObjectBase<derivedF>& F, //Faces
@@ -80,19 +95,19 @@ IGL_INLINE int compute_cut_cgal(const Eigen::PlainObjectBase<derivedV>& V, //Ver
 
 
 //Utility function: Given a mesh, and a cut, return a mesh where the edges have been cut so the resulting mesh can be used with a flattening algorithm
-template <typename derivedV, typename derivedE, typename indexType, typename derivedCut, typename derivedRetV, typename derivedRetE>
+template <typename derivedV, typename derivedF, typename derivedTTi, typename derivedE, typename derivedEMAP, typename indexType, typename cornerType, typename derivedCut, typename derivedRetV, typename derivedRetE>
 IGL_INLINE void cut_mesh(const Eigen::PlainObjectBase<derivedV>& V, //Vertices
-                        const Eigen::PlainObjectBase<derivedE>& F, //Faces
+                        const Eigen::PlainObjectBase<derivedF>& F, //Faces
                         const Eigen::PlainObjectBase<derivedE>& E, //Edges
-                        const Eigen::PlainObjectBase<derivedE>& edgesC, //EMAP
-                        const Eigen::PlainObjectBase<derivedE>& TT, //TT from triangle_triangle_adjacency
-                        const Eigen::PlainObjectBase<derivedE>& TTi, //TTi from triangle_triangle_adjacency
+                        const Eigen::PlainObjectBase<derivedEMAP>& edgesC, //EMAP
+                        const Eigen::PlainObjectBase<derivedF>& TT, //TT from triangle_triangle_adjacency
+                        const Eigen::PlainObjectBase<derivedTTi>& TTi, //TTi from triangle_triangle_adjacency
                         const std::vector<std::vector<indexType> >& VF, //VF from vertex_triangle_adjacency
-                        const std::vector<std::vector<indexType> >& VFi, //VFi from vertex_triangle_adjacency
+                        const std::vector<std::vector<cornerType> >& VFi, //VFi from vertex_triangle_adjacency
                         const std::vector<bool>& isB,//Is a vertex a bdry
                         const Eigen::PlainObjectBase<derivedCut>& cut, //indices to cut edges
-                        Eigen::PlainObjectBase<derivedV>& retV, //return value V
-                        Eigen::PlainObjectBase<derivedE>& retF); //return value F
+                        Eigen::PlainObjectBase<derivedRetV>& retV, //return value V
+                        Eigen::PlainObjectBase<derivedRetE>& retF); //return value F
 
 
 #ifndef IGL_STATIC_LIBRARY
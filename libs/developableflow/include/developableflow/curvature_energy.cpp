@@ -34,12 +34,12 @@
 #include <igl/cotmatrix_entries.h>
 
 
-template <typename derivedV, typename derivedF, typename indexType, typename derivedEnergy, typename derivedEnergyGrad>
+template <typename derivedV, typename derivedF, typename indexType, typename cornerType, typename derivedEnergy, typename derivedEnergyGrad>
 IGL_INLINE void curvature_energy_and_grad(
                                       const Eigen::PlainObjectBase<derivedV>& V,
                                       const Eigen::PlainObjectBase<derivedF>& F,
                                       const std::vector<std::vector<indexType> >& VF,
-                                      const std::vector<std::vector<indexType> >& VFi,
+                                      const std::vector<std::vector<cornerType> >& VFi,
                                       const std::vector<bool>& isB,
                                       Eigen::PlainObjectBase<derivedEnergy>& energy,
                                       Eigen::PlainObjectBase<derivedEnergyGrad>& energyGrad)
@@ -77,7 +77,7 @@ IGL_INLINE void curvature_energy_and_grad(
         }
         
         const std::vector<indexType>& adjacentFaces = VF[vert];
-        const std::vector<indexType>& adjacentFacesi = VFi[vert];
+        const std::vector<cornerType>& adjacentFacesi = VFi[vert];
         t_V_s anglesum = 0.;
         t_V_s A = 0.;
         for(int f=0; f<adjacentFaces.size(); ++f) {
@@ -135,12 +135,12 @@ IGL_INLINE void curvature_energy_and_grad(
 }
 
 
-template <typename derivedV, typename derivedF, typename indexType, typename derivedEnergy>
+template <typename derivedV, typename derivedF, typename indexType, typename cornerType, typename derivedEnergy>
 IGL_INLINE void curvature_energy(
                              const Eigen::PlainObjectBase<derivedV>& V,
                              const Eigen::PlainObjectBase<derivedF>& F,
                              const std::vector<std::vector<indexType> >& VF,
-                             const std::vector<std::vector<indexType> >& VFi,
+                             const std::vector<std::vector<cornerType> >& VFi,
                              const std::vector<bool>& isB,
                              Eigen::PlainObjectBase<derivedEnergy>& energy)
 {
@@ -171,7 +171,7 @@ IGL_INLINE void curvature_energy(
         }
         
         const std::vector<indexType>& adjacentFaces = VF[vert];
-        const std::vector<indexType>& adjacentFacesi = VFi[vert];
+        const std::vector<cornerType>& adjacentFacesi = VFi[vert];
         t_V_s anglesum = 0.;
         t_V_s A = 0.;
         for(int f=0; f<adjacentFaces.size(); ++f) {
@@ -0,0 +1,301 @@
+/*
+
+ 2018, Oded Stein, Eitan Grinspun and Keenan Crane
+
+ This file is part of the code for "Developability of Triangle Meshes".
+
+ The code for "Developability of Triangle Meshes" is free software: you can
+ redistribute it and/or modify it under the terms of the GNU General Public
+ License as published by the Free Software Foundation, either version 2 of the
+ License, or (at your option) any later version.
+
+ The code for "Developability of Triangle Meshes" is distributed in the hope
+ that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with the code for "Developability of Triangle Meshes". If not,
+ see <https://www.gnu.org/licenses/>.
+
+ */
+
+
+#include "cut_graph.h"
+
+#include <Eigen/Geometry>
+#include <limits>
+#include <algorithm>
+
+
+#define HEAP_ARITY 4
+
+
+template <typename derivedV, typename derivedF, typename derivedEMAP, typename derivedDirs, typename t_s, typename t_i>
+IGL_INLINE void build_cut_graph(const Eigen::PlainObjectBase<derivedV>& V,
+                                const Eigen::PlainObjectBase<derivedF>& F,
+                                const Eigen::PlainObjectBase<derivedEMAP>& edgesC,
+                                const std::vector<bool>& isB,
+                                const Eigen::PlainObjectBase<derivedDirs>& minCurvatureDirs,
+                                CutGraph<t_s, t_i>& graph)
+{
+    typedef Eigen::Matrix<t_s, 3, 1> t_V3;
+
+    const t_i nV = V.rows();
+    const t_i nF = F.rows();
+
+    //Count the outgoing halfedges of each vertex, one per face corner
+    graph.offsets.assign(nV+1, 0);
+    for(t_i f=0; f<nF; ++f)
+        for(int j=0; j<3; ++j)
+            ++graph.offsets[F(f,j)+1];
+    for(t_i v=0; v<nV; ++v)
+        graph.offsets[v+1] += graph.offsets[v];
+
+    graph.heads.resize(3*nF);
+    graph.edges.resize(3*nF);
+    graph.costs.resize(3*nF);
+    std::vector<t_i> fill(graph.offsets.begin(), graph.offsets.end()-1);
+    for(t_i f=0; f<nF; ++f) {
+        for(int j=0; j<3; ++j) {
+            const t_i v = F(f,j);
+            const t_i w = F(f,(j+1)%3);
+            const t_i h = fill[v]++;
+            graph.heads[h] = w;
+            graph.edges[h] = edgesC(f + nF*((j+2)%3));
+
+            if(isB[v] && isB[w]) {
+                graph.costs[h] = std::numeric_limits<t_s>::infinity();
+            } else {
+                t_V3 edgevec = (V.row(w) - V.row(v)).transpose();
+                const t_s enorm = edgevec.norm(); edgevec /= enorm;
+                const t_V3 dir = minCurvatureDirs.row(v).transpose();
+                graph.costs[h] = dir.cross(edgevec).norm() + enorm;
+            }
+        }
+    }
+}
+
+
+template <typename t_s, typename t_i>
+IGL_INLINE void reverse_cut_graph(const CutGraph<t_s, t_i>& graph,
+                                  CutGraph<t_s, t_i>& reversed)
+{
+    const t_i nV = graph.n_vertices();
+    const t_i nH = graph.heads.size();
+
+    reversed.offsets.assign(nV+1, 0);
+    for(t_i h=0; h<nH; ++h)
+        ++reversed.offsets[graph.heads[h]+1];
+    for(t_i v=0; v<nV; ++v)
+        reversed.offsets[v+1] += reversed.offsets[v];
+
+    reversed.heads.resize(nH);
+    reversed.edges.resize(nH);
+    reversed.costs.resize(nH);
+    std::vector<t_i> fill(reversed.offsets.begin(), reversed.offsets.end()-1);
+    for(t_i v=0; v<nV; ++v) {
+        for(t_i h=graph.offsets[v]; h<graph.offsets[v+1]; ++h) {
+            const t_i r = fill[graph.heads[h]]++;
+            reversed.heads[r] = v;
+            reversed.edges[r] = graph.edges[h];
+            reversed.costs[r] = graph.costs[h];
+        }
+    }
+}
+
+
+template <typename t_s, typename t_i>
+IGL_INLINE CutDijkstra<t_s, t_i>::CutDijkstra(const CutGraph<t_s, t_i>& graph) :
+g(graph),
+dist(graph.n_vertices(), std::numeric_limits<t_s>::infinity()),
+prevVertex(graph.n_vertices(), -1),
+prevHalfedge(graph.n_vertices(), -1),
+origin(graph.n_vertices(), -1),
+heapPos(graph.n_vertices(), -1)
+{
+    heap.reserve(graph.n_vertices());
+    touched.reserve(graph.n_vertices());
+}
+
+
+template <typename t_s, typename t_i>
+IGL_INLINE void CutDijkstra<t_s, t_i>::reset()
+{
+    for(const t_i& v : touched) {
+        dist[v] = std::numeric_limits<t_s>::infinity();
+        prevVertex[v] = -1;
+        prevHalfedge[v] = -1;
+        origin[v] = -1;
+        heapPos[v] = -1;
+    }
+    touched.clear();
+    heap.clear();
+}
+
+
+template <typename t_s, typename t_i>
+IGL_INLINE void CutDijkstra<t_s, t_i>::run(const t_i& source,
+                                           const std::vector<t_i>& targetIds,
+                                           const t_i& nTargets)
+{
+    reset();
+    add_source(source, 0);
+    settle(targetIds, nTargets);
+}
+
+
+template <typename t_s, typename t_i>
+IGL_INLINE void CutDijkstra<t_s, t_i>::run_voronoi(const std::vector<t_i>& sources)
+{
+    reset();
+    for(t_i i=0; i<sources.size(); ++i)
+        if(origin[sources[i]] < 0)
+            add_source(sources[i], i);
+    settle(std::vector<t_i>(), 0);
+}
+
+
+template <typename t_s, typename t_i>
+IGL_INLINE void CutDijkstra<t_s, t_i>::add_source(const t_i& source, const t_i& sourceIndex)
+{
+    dist[source] = 0.;
+    origin[source] = sourceIndex;
+    touched.push_back(source);
+    heap_push_or_decrease(source);
+}
+
+
+template <typename t_s, typename t_i>
+IGL_INLINE void CutDijkstra<t_s, t_i>::settle(const std::vector<t_i>& targetIds, const t_i& nTargets)
+{
+    t_i targetsSettled = 0;
+    while(!heap.empty()) {
+        const t_i u = heap_pop();
+
+        if(!targetIds.empty() && targetIds[u]>=0 && ++targetsSettled==nTargets)
+            break;
+
+        const t_s du = dist[u];
+        for(t_i h=g.offsets[u]; h<g.offsets[u+1]; ++h) {
+            const t_i& v = g.heads[h];
+            const t_s distThroughU = du + g.costs[h];
+            if(distThroughU < dist[v]) {
+                if(dist[v] == std::numeric_limits<t_s>::infinity())
+                    touched.push_back(v);
+                dist[v] = distThroughU;
+                prevVertex[v] = u;
+                prevHalfedge[v] = h;
+                origin[v] = origin[u];
+                heap_push_or_decrease(v);
+            }
+        }
+    }
+}
+
+
+template <typename t_s, typename t_i>
+IGL_INLINE t_s CutDijkstra<t_s, t_i>::distance(const t_i& v) const
+{
+    return dist[v];
+}
+
+
+template <typename t_s, typename t_i>
+IGL_INLINE t_i CutDijkstra<t_s, t_i>::nearest_source(const t_i& v) const
+{
+    return origin[v];
+}
+
+
+template <typename t_s, typename t_i>
+IGL_INLINE t_i CutDijkstra<t_s, t_i>::previous(const t_i& v) const
+{
+    return prevVertex[v];
+}
+
+
+template <typename t_s, typename t_i>
+IGL_INLINE t_i CutDijkstra<t_s, t_i>::previous_edge(const t_i& v) const
+{
+    return prevHalfedge[v]<0 ? -1 : g.edges[prevHalfedge[v]];
+}
+
+
+template <typename t_s, typename t_i>
+IGL_INLINE void CutDijkstra<t_s, t_i>::path_edges(const t_i& v, std::vector<t_i>& pathEdges) const
+{
+    for(t_i current=v; prevVertex[current]>=0; current=prevVertex[current])
+        pathEdges.push_back(g.edges[prevHalfedge[current]]);
+}
+
+
+template <typename t_s, typename t_i>
+IGL_INLINE void CutDijkstra<t_s, t_i>::heap_push_or_decrease(const t_i& v)
+{
+    if(heapPos[v] < 0) {
+        heapPos[v] = heap.size();
+        heap.push_back(v);
+    }
+    sift_up(heapPos[v]);
+}
+
+
+template <typename t_s, typename t_i>
+IGL_INLINE t_i CutDijkstra<t_s, t_i>::heap_pop()
+{
+    const t_i top = heap.front();
+    heapPos[top] = -2; //settled
+    const t_i last = heap.back();
+    heap.pop_back();
+    if(!heap.empty()) {
+        heap.front() = last;
+        heapPos[last] = 0;
+        sift_down(0);
+    }
+    return top;
+}
+
+
+template <typename t_s, typename t_i>
+IGL_INLINE void CutDijkstra<t_s, t_i>::sift_up(t_i pos)
+{
+    const t_i v = heap[pos];
+    const t_s key = dist[v];
+    while(pos > 0) {
+        const t_i parent = (pos-1) / HEAP_ARITY;
+        if(dist[heap[parent]] <= key)
+            break;
+        heap[pos] = heap[parent];
+        heapPos[heap[pos]] = pos;
+        pos = parent;
+    }
+    heap[pos] = v;
+    heapPos[v] = pos;
+}
+
+
+template <typename t_s, typename t_i>
+IGL_INLINE void CutDijkstra<t_s, t_i>::sift_down(t_i pos)
+{
+    const t_i size = heap.size();
+    const t_i v = heap[pos];
+    const t_s key = dist[v];
+    while(true) {
+        const t_i firstChild = HEAP_ARITY*pos + 1;
+        if(firstChild >= size)
+            break;
+        const t_i lastChild = std::min<t_i>(firstChild+HEAP_ARITY, size);
+        t_i minChild = firstChild;
+        for(t_i c=firstChild+1; c<lastChild; ++c)
+            if(dist[heap[c]] < dist[heap[minChild]])
+                minChild = c;
+        if(key <= dist[heap[minChild]])
+            break;
+        heap[pos] = heap[minChild];
+        heapPos[heap[pos]] = pos;
+        pos = minChild;
+    }
+    heap[pos] = v;
+    heapPos[v] = pos;
+}
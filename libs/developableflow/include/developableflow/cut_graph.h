@@ -0,0 +1,113 @@
+/*
+
+ 2018, Oded Stein, Eitan Grinspun and Keenan Crane
+
+ This file is part of the code for "Developability of Triangle Meshes".
+
+ The code for "Developability of Triangle Meshes" is free software: you can
+ redistribute it and/or modify it under the terms of the GNU General Public
+ License as published by the Free Software Foundation, either version 2 of the
+ License, or (at your option) any later version.
+
+ The code for "Developability of Triangle Meshes" is distributed in the hope
+ that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with the code for "Developability of Triangle Meshes". If not,
+ see <https://www.gnu.org/licenses/>.
+
+ */
+
+
+#ifndef DEVELOPABLEFLOW_CUT_GRAPH_H
+#define DEVELOPABLEFLOW_CUT_GRAPH_H
+
+#include <igl/igl_inline.h>
+
+#include <Eigen/Core>
+#include <vector>
+
+
+//Halfedge graph used by the cut computations, in CSR form.
+//The outgoing halfedges of vertex v are offsets[v] .. offsets[v+1]-1, one per adjacent face corner.
+template <typename t_s, typename t_i>
+struct CutGraph
+{
+    std::vector<t_i> offsets; //nV+1 offsets into the halfedge arrays
+    std::vector<t_i> heads; //head vertex of each halfedge
+    std::vector<t_i> edges; //undirected edge (EMAP) of each halfedge
+    std::vector<t_s> costs; //precomputed cost of each halfedge
+
+    t_i n_vertices() const {return offsets.size()-1;}
+};
+
+
+//Build the cut graph. The cost of a halfedge is its length plus how far it deviates from the min curvature direction at its tail,
+//halfedges between two boundary vertices get infinite cost.
+template <typename derivedV, typename derivedF, typename derivedEMAP, typename derivedDirs, typename t_s, typename t_i>
+IGL_INLINE void build_cut_graph(const Eigen::PlainObjectBase<derivedV>& V, //Vertices
+                                const Eigen::PlainObjectBase<derivedF>& F, //Faces
+                                const Eigen::PlainObjectBase<derivedEMAP>& edgesC, //EMAP
+                                const std::vector<bool>& isB, //Is a vertex a bdry
+                                const Eigen::PlainObjectBase<derivedDirs>& minCurvatureDirs, //Per-vertex min curvature direction from hinge_energy
+                                CutGraph<t_s, t_i>& graph); //return value graph
+
+
+//The same graph with every halfedge reversed, keeping its cost and edge. Shortest paths from v on the reversed graph are the shortest paths to v.
+template <typename t_s, typename t_i>
+IGL_INLINE void reverse_cut_graph(const CutGraph<t_s, t_i>& graph, //Graph to reverse
+                                  CutGraph<t_s, t_i>& reversed); //return value reversed graph
+
+
+//Shortest paths on a CutGraph with a 4-ary heap.
+//All scratch arrays are allocated once, and only the vertices touched by the last run are reset before the next one.
+template <typename t_s, typename t_i>
+class CutDijkstra
+{
+public:
+    IGL_INLINE CutDijkstra(const CutGraph<t_s, t_i>& graph);
+
+    //Run from source. If targetIds is not empty (one entry per vertex, -1 for non-targets), stop once nTargets targets are settled.
+    IGL_INLINE void run(const t_i& source,
+                        const std::vector<t_i>& targetIds = std::vector<t_i>(),
+                        const t_i& nTargets = 0);
+
+    //Run from all sources at once. This builds the geodesic Voronoi diagram of the sources, see nearest_source.
+    IGL_INLINE void run_voronoi(const std::vector<t_i>& sources);
+
+    //Results of the last run, valid for all vertices that were reached
+    IGL_INLINE t_s distance(const t_i& v) const;
+    IGL_INLINE t_i nearest_source(const t_i& v) const; //index into the sources of the last run whose Voronoi cell contains v, -1 if unreached
+    IGL_INLINE t_i previous(const t_i& v) const; //previous vertex on the shortest path, -1 at the source and for unreached vertices
+    IGL_INLINE t_i previous_edge(const t_i& v) const; //undirected edge (EMAP) leading into v
+
+    //Append the edges on the shortest path from the source to v
+    IGL_INLINE void path_edges(const t_i& v, std::vector<t_i>& pathEdges) const;
+
+private:
+    IGL_INLINE void reset();
+    IGL_INLINE void add_source(const t_i& source, const t_i& sourceIndex);
+    IGL_INLINE void settle(const std::vector<t_i>& targetIds, const t_i& nTargets);
+    IGL_INLINE void heap_push_or_decrease(const t_i& v);
+    IGL_INLINE t_i heap_pop();
+    IGL_INLINE void sift_up(t_i pos);
+    IGL_INLINE void sift_down(t_i pos);
+
+    const CutGraph<t_s, t_i>& g;
+    std::vector<t_s> dist;
+    std::vector<t_i> prevVertex, prevHalfedge;
+    std::vector<t_i> origin; //source each vertex was reached from
+    std::vector<t_i> heap; //4-ary min heap of vertices, keyed by dist
+    std::vector<t_i> heapPos; //position of each vertex in the heap, -1 if not in the heap
+    std::vector<t_i> touched; //vertices whose dist was written in the last run
+};
+
+
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "cut_graph.cpp"
+#endif
+
+#endif
@@ -0,0 +1,158 @@
+/*
+
+ 2018, Oded Stein, Eitan Grinspun and Keenan Crane
+
+ This file is part of the code for "Developability of Triangle Meshes".
+
+ The code for "Developability of Triangle Meshes" is free software: you can
+ redistribute it and/or modify it under the terms of the GNU General Public
+ License as published by the Free Software Foundation, either version 2 of the
+ License, or (at your option) any later version.
+
+ The code for "Developability of Triangle Meshes" is distributed in the hope
+ that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with the code for "Developability of Triangle Meshes". If not,
+ see <https://www.gnu.org/licenses/>.
+
+ */
+
+
+#include "cut_wedges.h"
+
+#include <tools/thread_pool.h>
+
+#include <vector>
+
+
+//Valences up to this are grouped in stack arrays, only higher ones allocate
+#define SMALL_VALENCE 32
+
+
+template <typename derivedV, typename derivedF, typename derivedTTi, typename derivedEMAP, typename indexType, typename cornerType, typename derivedCut, typename derivedRetV, typename derivedRetF, typename derivedWedgeMap>
+IGL_INLINE int cut_wedges(const Eigen::PlainObjectBase<derivedV>& V,
+                          const Eigen::PlainObjectBase<derivedF>& F,
+                          const Eigen::PlainObjectBase<derivedEMAP>& edgesC,
+                          const Eigen::PlainObjectBase<derivedF>& TT,
+                          const Eigen::PlainObjectBase<derivedTTi>& TTi,
+                          const std::vector<std::vector<indexType> >& VF,
+                          const std::vector<std::vector<cornerType> >& VFi,
+                          const Eigen::PlainObjectBase<derivedCut>& cut,
+                          Eigen::PlainObjectBase<derivedRetV>& retV,
+                          Eigen::PlainObjectBase<derivedRetF>& retF,
+                          Eigen::PlainObjectBase<derivedWedgeMap>& wedgeToVertex)
+{
+    typedef typename derivedF::Scalar t_F_i;
+
+    const t_F_i nV = V.rows();
+    const t_F_i nF = F.rows();
+
+    //Compute an edge cut bool
+    const t_F_i nE = edgesC.size()>0 ? edgesC.maxCoeff()+1 : 0;
+    std::vector<char> isCut(nE, 0);
+    for(int i=0; i<cut.size(); ++i)
+        isCut[cut(i)] = 1;
+
+    //Local wedge of every corner (3*face+j), and number of wedges of every vertex
+    std::vector<t_F_i> cornerWedge(3*nF);
+    std::vector<t_F_i> wedgeOffsets(nV+1, 0);
+
+    const auto group_vertex = [&] (const int& vert) {
+        const std::vector<indexType>& adjFaces = VF[vert];
+        const std::vector<cornerType>& adjFacesi = VFi[vert];
+        const int k = adjFaces.size();
+
+        int smallParent[SMALL_VALENCE], smallRank[SMALL_VALENCE];
+        std::vector<int> largeParent, largeRank;
+        if(k > SMALL_VALENCE) {
+            largeParent.resize(k);
+            largeRank.resize(k);
+        }
+        int* parent = k>SMALL_VALENCE ? largeParent.data() : smallParent;
+        int* rank = k>SMALL_VALENCE ? largeRank.data() : smallRank;
+        for(int i=0; i<k; ++i) {
+            parent[i] = i;
+            rank[i] = -1;
+        }
+        const auto find_root = [parent] (int i) {
+            while(parent[i] != i) {
+                parent[i] = parent[parent[i]];
+                i = parent[i];
+            }
+            return i;
+        };
+
+        //Join the corners on both sides of every uncut interior edge leaving vert
+        for(int i=0; i<k; ++i) {
+            const t_F_i face = adjFaces[i];
+            const int j = adjFacesi[i];
+            const t_F_i adjFace = TT(face, j);
+            if(adjFace < 0 || isCut[edgesC(face + nF*((j+2)%3))])
+                continue;
+            const int adjJ = (TTi(face, j)+1)%3;
+            for(int l=0; l<k; ++l) {
+                if(adjFaces[l]==adjFace && adjFacesi[l]==adjJ) {
+                    parent[find_root(i)] = find_root(l);
+                    break;
+                }
+            }
+        }
+
+        //Number the fans
+        int nWedges = 0;
+        for(int i=0; i<k; ++i) {
+            const int root = find_root(i);
+            if(rank[root] < 0)
+                rank[root] = nWedges++;
+            cornerWedge[3*adjFaces[i] + adjFacesi[i]] = rank[root];
+        }
+        wedgeOffsets[vert+1] = nWedges;
+    };
+
+    const auto assign_face = [&] (const int& face) {
+        for(int j=0; j<3; ++j)
+            retF(face, j) = wedgeOffsets[F(face,j)] + cornerWedge[3*face + j];
+    };
+
+    const auto assign_vertex = [&] (const int& vert) {
+        for(t_F_i w=wedgeOffsets[vert]; w<wedgeOffsets[vert+1]; ++w) {
+            retV.row(w) = V.row(vert);
+            wedgeToVertex(w) = vert;
+        }
+    };
+
+
+#ifndef PARALLEL_COMPUTATION
+    //SERIAL VERSION
+    for(int vert=0; vert<nV; ++vert)
+        group_vertex(vert);
+#else
+    //PARALLEL VERSION
+    solver_parallel_for(nV, group_vertex);
+#endif
+
+    for(t_F_i vert=0; vert<nV; ++vert)
+        wedgeOffsets[vert+1] += wedgeOffsets[vert];
+    const t_F_i nWedges = wedgeOffsets[nV];
+
+    retF.resize(nF, 3);
+    retV.resize(nWedges, V.cols());
+    wedgeToVertex.resize(nWedges);
+
+#ifndef PARALLEL_COMPUTATION
+    //SERIAL VERSION
+    for(int face=0; face<nF; ++face)
+        assign_face(face);
+    for(int vert=0; vert<nV; ++vert)
+        assign_vertex(vert);
+#else
+    //PARALLEL VERSION
+    solver_parallel_for(nF, assign_face);
+    solver_parallel_for(nV, assign_vertex);
+#endif
+
+    return nWedges;
+}
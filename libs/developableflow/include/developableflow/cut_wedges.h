@@ -0,0 +1,56 @@
+/*
+
+ 2018, Oded Stein, Eitan Grinspun and Keenan Crane
+
+ This file is part of the code for "Developability of Triangle Meshes".
+
+ The code for "Developability of Triangle Meshes" is free software: you can
+ redistribute it and/or modify it under the terms of the GNU General Public
+ License as published by the Free Software Foundation, either version 2 of the
+ License, or (at your option) any later version.
+
+ The code for "Developability of Triangle Meshes" is distributed in the hope
+ that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with the code for "Developability of Triangle Meshes". If not,
+ see <https://www.gnu.org/licenses/>.
+
+ */
+
+
+#ifndef DEVELOPABLEFLOW_CUT_WEDGES_H
+#define DEVELOPABLEFLOW_CUT_WEDGES_H
+
+#include <igl/igl_inline.h>
+
+#include <Eigen/Core>
+#include <vector>
+
+
+//Split the mesh along the cut. Every vertex gets one copy (wedge) per fan of faces between two cut or boundary edges.
+//The corners of each vertex are grouped with a small local union-find, so this is one linear pass, parallel over vertices.
+//Wedges are numbered vertex by vertex, so the wedges of vertex v are consecutive.
+//Returns the number of wedges.
+template <typename derivedV, typename derivedF, typename derivedTTi, typename derivedEMAP, typename indexType, typename cornerType, typename derivedCut, typename derivedRetV, typename derivedRetF, typename derivedWedgeMap>
+IGL_INLINE int cut_wedges(const Eigen::PlainObjectBase<derivedV>& V, //Vertices
+                          const Eigen::PlainObjectBase<derivedF>& F, //Faces
+                          const Eigen::PlainObjectBase<derivedEMAP>& edgesC, //EMAP
+                          const Eigen::PlainObjectBase<derivedF>& TT, //TT from triangle_triangle_adjacency
+                          const Eigen::PlainObjectBase<derivedTTi>& TTi, //TTi from triangle_triangle_adjacency
+                          const std::vector<std::vector<indexType> >& VF, //VF from vertex_triangle_adjacency
+                          const std::vector<std::vector<cornerType> >& VFi, //VFi from vertex_triangle_adjacency
+                          const Eigen::PlainObjectBase<derivedCut>& cut, //indices to cut edges
+                          Eigen::PlainObjectBase<derivedRetV>& retV, //return value V, one row per wedge
+                          Eigen::PlainObjectBase<derivedRetF>& retF, //return value F, wedge index of every corner
+                          Eigen::PlainObjectBase<derivedWedgeMap>& wedgeToVertex); //return value, original vertex of every wedge
+
+
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "cut_wedges.cpp"
+#endif
+
+#endif
@@ -1,13 +1,21 @@
 #include <compute_cut.h>
 #include <curvature_energy.h>
+#include <cut_graph.h>
+#include <cut_wedges.h>
 #include <energy_selector.h>
 #include <exactfcts_bisectors.h>
+#include <flatten_charts.h>
 #include <flatten_cut.h>
 #include <hinge_energy.h>
+#include <incremental_cut.h>
 #include <hingepairs_energy.h>
+#include <isotropic_remeshing.h>
 #include <max_hinge_energy.h>
 #include <measure_once_cut_twice.h>
 #include <mesh_postprocessing.h>
+#include <native_parameterization.h>
+#include <scp_solver.h>
+#include <select_punctures.h>
 #include <old_hinge_energy.h>
 #include <old_max_hinge_energy.h>
 #include <timestep.h>
\ No newline at end of file
@@ -33,17 +33,19 @@
 #include <igl/per_face_normals.h>
 #include <igl/per_vertex_normals.h>
 
+#include <iostream>
+
 
 //Infinity
 #define INFTY std::numeric_limits<double>::infinity()
 
 
-template <typename derivedV, typename derivedF, typename indexType, typename derivedEnergy, typename derivedEnergyGrad>
+template <typename derivedV, typename derivedF, typename indexType, typename cornerType, typename derivedEnergy, typename derivedEnergyGrad>
 IGL_INLINE void energy_selector(const EnergyType energyType,
                                 const Eigen::PlainObjectBase<derivedV>& V,
                                 const Eigen::PlainObjectBase<derivedF>& F,
                                 const std::vector<std::vector<indexType> >& VF,
-                                const std::vector<std::vector<indexType> >& VFi,
+                                const std::vector<std::vector<cornerType> >& VFi,
                                 const std::vector<bool>& isB,
                                 Eigen::PlainObjectBase<derivedEnergy>& energy,
                                 Eigen::PlainObjectBase<derivedEnergyGrad>& energyGrad)
@@ -51,9 +53,9 @@ IGL_INLINE void energy_selector(const EnergyType energyType,
     typedef typename derivedEnergy::Scalar t_energy_s;
     typedef Eigen::Matrix<t_energy_s, Eigen::Dynamic, 1> t_energy;
     typedef typename derivedEnergyGrad::Scalar t_energyGrad_s;
-    typedef Eigen::Matrix<t_energyGrad_s, Eigen::Dynamic, 3> t_energyGrad;
+    typedef Eigen::Matrix<t_energyGrad_s, Eigen::Dynamic, 3, (derivedEnergyGrad::IsRowMajor ? Eigen::RowMajor : Eigen::ColMajor)> t_energyGrad;
     typedef typename derivedV::Scalar t_V_s;
-    typedef Eigen::Matrix<t_V_s, Eigen::Dynamic, 3> t_V;
+    typedef Eigen::Matrix<t_V_s, Eigen::Dynamic, 3, (derivedV::IsRowMajor ? Eigen::RowMajor : Eigen::ColMajor)> t_V;
     typedef Eigen::Matrix<t_V_s, Eigen::Dynamic, 1> t_Vv;
     typedef Eigen::SparseMatrix<t_V_s> t_Vs;
     typedef Eigen::Matrix<t_V_s, 3, 1> t_V3;
@@ -85,3 +87,43 @@ IGL_INLINE void energy_selector(const EnergyType energyType,
     assert(energy==energy && "There are nans in the energy");
     assert(energyGrad==energyGrad && "There are nans in the energyGrad");
 }
+
+
+template <typename derivedV, typename derivedF, typename indexType, typename cornerType, typename derivedEnergy>
+IGL_INLINE void energy_selector(const EnergyType energyType,
+                                const Eigen::PlainObjectBase<derivedV>& V,
+                                const Eigen::PlainObjectBase<derivedF>& F,
+                                const std::vector<std::vector<indexType> >& VF,
+                                const std::vector<std::vector<cornerType> >& VFi,
+                                const std::vector<bool>& isB,
+                                Eigen::PlainObjectBase<derivedEnergy>& energy)
+{
+    switch(energyType) {
+        case ENERGY_TYPE_HINGE:
+            hinge_energy(V, F, VF, VFi, isB, energy);
+            break;
+        case ENERGY_TYPE_MINWIDTH:
+            max_hinge_energy(V, F, VF, VFi, isB, energy);
+            break;
+        case ENERGY_TYPE_OLDHINGE:
+            old_hinge_energy(V, F, VF, VFi, isB, energy);
+            break;
+        case ENERGY_TYPE_OLDMINWIDTH: {
+            //old_max_hinge_energy without gradient is an older formulation that does not match the flow's energy
+            Eigen::Matrix<typename derivedV::Scalar, Eigen::Dynamic, 3> energyGrad;
+            old_max_hinge_energy_and_grad(V, F, VF, VFi, isB, energy, energyGrad);
+            break;
+        }
+        case ENERGY_TYPE_PAIRWISENORMALS:
+            hingepairs_energy(V, F, VF, VFi, isB, energy);
+            break;
+        case ENERGY_TYPE_MAXPAIRWISENORMALS:
+            maxhingepairs_energy(V, F, VF, VFi, isB, energy);
+            break;
+        default:
+            std::cout << "Such an energy type does not exist." << std::endl;
+    }
+    
+    
+    assert(energy==energy && "There are nans in the energy");
+}
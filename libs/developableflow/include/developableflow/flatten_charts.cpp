@@ -0,0 +1,233 @@
+/*
+
+ 2018, Oded Stein, Eitan Grinspun and Keenan Crane
+
+ This file is part of the code for "Developability of Triangle Meshes".
+
+ The code for "Developability of Triangle Meshes" is free software: you can
+ redistribute it and/or modify it under the terms of the GNU General Public
+ License as published by the Free Software Foundation, either version 2 of the
+ License, or (at your option) any later version.
+
+ The code for "Developability of Triangle Meshes" is distributed in the hope
+ that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with the code for "Developability of Triangle Meshes". If not,
+ see <https://www.gnu.org/licenses/>.
+
+ */
+
+
+#include "flatten_charts.h"
+
+#include <tools/thread_pool.h>
+
+#include <Eigen/Geometry>
+
+#include <algorithm>
+#include <cmath>
+
+
+template <typename derivedF>
+IGL_INLINE int mesh_components(const Eigen::PlainObjectBase<derivedF>& F,
+                               const int& nV,
+                               std::vector<int>& faceComponent)
+{
+    //Union-find over the vertices
+    std::vector<int> parent(nV);
+    for(int v=0; v<nV; ++v)
+        parent[v] = v;
+    const auto find_root = [&parent] (int v) {
+        while(parent[v] != v) {
+            parent[v] = parent[parent[v]];
+            v = parent[v];
+        }
+        return v;
+    };
+    for(int face=0; face<F.rows(); ++face)
+        for(int j=1; j<3; ++j)
+            parent[find_root(F(face,j))] = find_root(F(face,0));
+    
+    std::vector<int> rootComponent(nV, -1);
+    int nComponents = 0;
+    faceComponent.resize(F.rows());
+    for(int face=0; face<F.rows(); ++face) {
+        const int root = find_root(F(face,0));
+        if(rootComponent[root] < 0)
+            rootComponent[root] = nComponents++;
+        faceComponent[face] = rootComponent[root];
+    }
+    
+    return nComponents;
+}
+
+
+template <typename derivedV, typename derivedF, typename derivedUV, typename derivedUVF>
+IGL_INLINE typename derivedV::Scalar flattened_area_scale(const Eigen::PlainObjectBase<derivedV>& V,
+                                                          const Eigen::PlainObjectBase<derivedF>& F,
+                                                          const Eigen::PlainObjectBase<derivedUV>& UV,
+                                                          const Eigen::PlainObjectBase<derivedUVF>& UVF,
+                                                          typename derivedV::Scalar& area3D)
+{
+    typedef typename derivedV::Scalar t_s;
+    typedef Eigen::Matrix<t_s, 3, 1> t_V3;
+    
+    t_s areaUV = 0;
+    area3D = 0;
+    for(int face=0; face<F.rows(); ++face) {
+        const t_V3 e1 = (V.row(F(face,1)) - V.row(F(face,0))).transpose();
+        const t_V3 e2 = (V.row(F(face,2)) - V.row(F(face,0))).transpose();
+        area3D += 0.5*e1.cross(e2).norm();
+        const t_s u1 = UV(UVF(face,1),0) - UV(UVF(face,0),0), v1 = UV(UVF(face,1),1) - UV(UVF(face,0),1);
+        const t_s u2 = UV(UVF(face,2),0) - UV(UVF(face,0),0), v2 = UV(UVF(face,2),1) - UV(UVF(face,0),1);
+        areaUV += 0.5*(u1*v2 - v1*u2);
+    }
+    
+    return std::abs(areaUV) > 0 ? std::sqrt(area3D/std::abs(areaUV)) : t_s(1);
+}
+
+
+template <typename derivedV, typename derivedF, typename flattenFunctionType, typename derivedRetV, typename derivedRetF>
+IGL_INLINE int flatten_charts(const Eigen::PlainObjectBase<derivedV>& V,
+                              const Eigen::PlainObjectBase<derivedF>& F,
+                              const std::vector<int>& faceChart,
+                              const int& nCharts,
+                              const flattenFunctionType& flatten_func,
+                              Eigen::PlainObjectBase<derivedRetV>& retV,
+                              Eigen::PlainObjectBase<derivedRetF>& retF)
+{
+    typedef typename derivedV::Scalar t_s;
+    typedef Eigen::Matrix<t_s, 2, 1> t_V2;
+    typedef Eigen::Matrix<t_s, Eigen::Dynamic, 3> t_V;
+    typedef Eigen::Matrix<t_s, Eigen::Dynamic, 2> t_UV;
+    typedef Eigen::Matrix<int, Eigen::Dynamic, 3> t_F;
+    
+    const int nF = F.rows();
+    
+    //Faces of every chart
+    std::vector<int> chartFaceOffsets(nCharts+1, 0);
+    for(int face=0; face<nF; ++face)
+        ++chartFaceOffsets[faceChart[face]+1];
+    for(int chart=0; chart<nCharts; ++chart)
+        chartFaceOffsets[chart+1] += chartFaceOffsets[chart];
+    std::vector<int> chartFaces(nF);
+    {
+        std::vector<int> fill(chartFaceOffsets.begin(), chartFaceOffsets.end()-1);
+        for(int face=0; face<nF; ++face)
+            chartFaces[fill[faceChart[face]]++] = face;
+    }
+    
+    //Chart-local vertices, a vertex is duplicated in every chart it belongs to
+    retF.resize(nF, 3);
+    std::vector<int> vertexChart(V.rows(), -1), vertexLocal(V.rows());
+    std::vector<int> chartVertices, chartVertexOffsets(1, 0);
+    for(int chart=0; chart<nCharts; ++chart) {
+        int nLocal = 0;
+        for(int i=chartFaceOffsets[chart]; i<chartFaceOffsets[chart+1]; ++i) {
+            const int& face = chartFaces[i];
+            for(int j=0; j<3; ++j) {
+                const int vert = F(face,j);
+                if(vertexChart[vert] != chart) {
+                    vertexChart[vert] = chart;
+                    vertexLocal[vert] = nLocal++;
+                    chartVertices.push_back(vert);
+                }
+                retF(face,j) = chartVertexOffsets[chart] + vertexLocal[vert];
+            }
+        }
+        chartVertexOffsets.push_back(chartVertices.size());
+    }
+    
+    //Largest charts first, so that they do not end up last on one thread
+    std::vector<int> order(nCharts);
+    for(int chart=0; chart<nCharts; ++chart)
+        order[chart] = chart;
+    std::sort(order.begin(), order.end(), [&chartFaceOffsets] (const int& a, const int& b) {
+        return chartFaceOffsets[a+1]-chartFaceOffsets[a] > chartFaceOffsets[b+1]-chartFaceOffsets[b];
+    });
+    
+    //Flatten every chart and scale it to its area in 3D
+    t_UV uv(chartVertices.size(), 2);
+    std::vector<int> chartRetVals(nCharts, 0);
+    std::vector<t_s> chartAreas(nCharts, 0);
+    const auto flatten_one = [&] (const int& i) {
+        const int& chart = order[i];
+        const int& vOffset = chartVertexOffsets[chart];
+        const int nLocalV = chartVertexOffsets[chart+1] - vOffset;
+        const int nLocalF = chartFaceOffsets[chart+1] - chartFaceOffsets[chart];
+        t_V chartV(nLocalV, 3);
+        for(int k=0; k<nLocalV; ++k)
+            chartV.row(k) = V.row(chartVertices[vOffset+k]);
+        t_F chartF(nLocalF, 3);
+        for(int k=0; k<nLocalF; ++k)
+            for(int j=0; j<3; ++j)
+                chartF(k,j) = retF(chartFaces[chartFaceOffsets[chart]+k], j) - vOffset;
+        
+        t_UV chartUV;
+        chartRetVals[chart] = flatten_func(chartV, chartF, chartUV);
+        if(chartUV.rows() != nLocalV) {
+            chartUV.setZero(nLocalV, 2);
+            if(chartRetVals[chart] == 0)
+                chartRetVals[chart] = 1;
+        }
+        
+        chartUV *= flattened_area_scale(chartV, chartF, chartUV, chartF, chartAreas[chart]);
+        uv.block(vOffset, 0, nLocalV, 2) = chartUV;
+    };
+    
+#ifndef PARALLEL_COMPUTATION
+    //SERIAL VERSION
+    for(int i=0; i<nCharts; ++i)
+        flatten_one(i);
+#else
+    //PARALLEL VERSION
+    solver_parallel_for(nCharts, flatten_one, 2);
+#endif
+    
+    //Lay the charts out in rows, tallest first
+    t_s totalArea = 0;
+    for(const t_s& area : chartAreas)
+        totalArea += area;
+    const t_s margin = CHART_MARGIN*std::sqrt(totalArea);
+    std::vector<t_V2> chartSizes(nCharts);
+    t_s packedArea = 0, maxWidth = 0;
+    for(int chart=0; chart<nCharts; ++chart) {
+        const int& vOffset = chartVertexOffsets[chart];
+        const int nLocalV = chartVertexOffsets[chart+1] - vOffset;
+        const t_V2 minCorner = uv.block(vOffset, 0, nLocalV, 2).colwise().minCoeff().transpose();
+        uv.block(vOffset, 0, nLocalV, 2).rowwise() -= minCorner.transpose();
+        chartSizes[chart] = uv.block(vOffset, 0, nLocalV, 2).colwise().maxCoeff().transpose();
+        packedArea += (chartSizes[chart](0)+margin) * (chartSizes[chart](1)+margin);
+        maxWidth = std::max(maxWidth, chartSizes[chart](0));
+    }
+    std::sort(order.begin(), order.end(), [&chartSizes] (const int& a, const int& b) {
+        return chartSizes[a](1) > chartSizes[b](1);
+    });
+    const t_s rowWidth = std::max(std::sqrt(packedArea), maxWidth);
+    t_s x = 0, y = 0, rowHeight = 0;
+    for(const int& chart : order) {
+        if(x > 0 && x + chartSizes[chart](0) > rowWidth) {
+            x = 0;
+            y += rowHeight + margin;
+            rowHeight = 0;
+        }
+        const int& vOffset = chartVertexOffsets[chart];
+        const int nLocalV = chartVertexOffsets[chart+1] - vOffset;
+        uv.block(vOffset, 0, nLocalV, 1).array() += x;
+        uv.block(vOffset, 1, nLocalV, 1).array() += y;
+        x += chartSizes[chart](0) + margin;
+        rowHeight = std::max(rowHeight, chartSizes[chart](1));
+    }
+    
+    retV.resize(uv.rows(), 3);
+    retV.leftCols(2) = uv;
+    retV.col(2).setZero();
+    
+    for(const int& chartRetVal : chartRetVals)
+        if(chartRetVal != 0)
+            return chartRetVal;
+    return 0;
+}
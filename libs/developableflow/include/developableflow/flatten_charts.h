@@ -0,0 +1,74 @@
+/*
+
+ 2018, Oded Stein, Eitan Grinspun and Keenan Crane
+
+ This file is part of the code for "Developability of Triangle Meshes".
+
+ The code for "Developability of Triangle Meshes" is free software: you can
+ redistribute it and/or modify it under the terms of the GNU General Public
+ License as published by the Free Software Foundation, either version 2 of the
+ License, or (at your option) any later version.
+
+ The code for "Developability of Triangle Meshes" is distributed in the hope
+ that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with the code for "Developability of Triangle Meshes". If not,
+ see <https://www.gnu.org/licenses/>.
+
+ */
+
+
+#ifndef DEVELOPABLEFLOW_FLATTEN_CHARTS_H
+#define DEVELOPABLEFLOW_FLATTEN_CHARTS_H
+
+#include <igl/igl_inline.h>
+
+#include <Eigen/Core>
+#include <vector>
+
+
+#define CHART_MARGIN 0.01 //Space between charts in the layout, relative to the square root of the total area
+
+
+//Connected components of a mesh, faces are connected if they share a vertex. For a cut mesh these are the charts.
+//Returns the number of components.
+template <typename derivedF>
+IGL_INLINE int mesh_components(const Eigen::PlainObjectBase<derivedF>& F, //Faces
+                               const int& nV, //Number of vertices
+                               std::vector<int>& faceComponent); //return value component of every face
+
+
+//Factor that scales the parameterization UV, UVF to the 3D surface area of V, F (faces in the same order).
+//Only the first two columns of UV are used. Returns 1 if the parameterization has no area.
+template <typename derivedV, typename derivedF, typename derivedUV, typename derivedUVF>
+IGL_INLINE typename derivedV::Scalar flattened_area_scale(const Eigen::PlainObjectBase<derivedV>& V, //Vertices
+                                                          const Eigen::PlainObjectBase<derivedF>& F, //Faces
+                                                          const Eigen::PlainObjectBase<derivedUV>& UV, //Parameterization
+                                                          const Eigen::PlainObjectBase<derivedUVF>& UVF, //Faces of the parameterization, same order as F
+                                                          typename derivedV::Scalar& area3D); //return value surface area of V, F
+
+
+//Flatten every chart of a mesh on its own with flatten_func(chartV, chartF, chartUV), concurrently on the solver thread pool,
+//where chartV, chartF and chartUV are Eigen::Matrix<Scalar, Dynamic, 3>, Eigen::Matrix<int, Dynamic, 3> and Eigen::Matrix<Scalar, Dynamic, 2>,
+//the largest charts first. Every chart is scaled to the area it has in 3D and the charts are laid out in rows.
+//Vertices shared by several charts are duplicated, retF has the faces of F in the same order.
+//Returns 0 on success, otherwise the first nonzero return value of flatten_func
+template <typename derivedV, typename derivedF, typename flattenFunctionType, typename derivedRetV, typename derivedRetF>
+IGL_INLINE int flatten_charts(const Eigen::PlainObjectBase<derivedV>& V, //Vertices
+                              const Eigen::PlainObjectBase<derivedF>& F, //Faces
+                              const std::vector<int>& faceChart, //Chart of every face
+                              const int& nCharts, //Number of charts
+                              const flattenFunctionType& flatten_func, //Flattens one chart, returns 0 on success
+                              Eigen::PlainObjectBase<derivedRetV>& retV, //return value uv coordinates, third column zero
+                              Eigen::PlainObjectBase<derivedRetF>& retF); //return value faces into retV
+
+
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "flatten_charts.cpp"
+#endif
+
+#endif
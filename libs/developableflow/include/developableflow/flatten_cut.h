@@ -26,44 +26,123 @@
 
 #include <igl/igl_inline.h>
 
+#include <developableflow/scp_solver.h>
+#include <tools/distortion_metrics.h>
+
 #include <Eigen/Core>
 #include <vector>
 
+//Flattens the cut mesh, scaled to its surface area in 3D whether the cut leaves one chart or several.
 //Returns 0 on success, error code otherwise
 
-template <typename derivedV, typename derivedE, typename indexType, typename derivedCut, typename derivedRetV, typename derivedRetE>
+template <typename derivedV, typename derivedF, typename derivedTTi, typename derivedE, typename derivedEMAP, typename indexType, typename cornerType, typename derivedCut, typename derivedRetV, typename derivedRetE>
+IGL_INLINE int flatten_cut(const Eigen::PlainObjectBase<derivedV>& V, //Vertices
+                           const Eigen::PlainObjectBase<derivedF>& F, //Faces
+                           const Eigen::PlainObjectBase<derivedE>& E, //Edges
+                           const Eigen::PlainObjectBase<derivedEMAP>& edgesC, //EMAP
+                           const Eigen::PlainObjectBase<derivedF>& TT, //TT from triangle_triangle_adjacency
+                           const Eigen::PlainObjectBase<derivedTTi>& TTi, //TTi from triangle_triangle_adjacency
+                           const std::vector<std::vector<indexType> >& VF, //VF from vertex_triangle_adjacency
+                           const std::vector<std::vector<cornerType> >& VFi, //VFi from vertex_triangle_adjacency
+                           const std::vector<bool>& isB, //isB from is_border_vertex
+                           const Eigen::PlainObjectBase<derivedCut>& cut, //indices to cut edges
+                           Eigen::PlainObjectBase<derivedRetV>& retV, //return mesh vertices
+                           Eigen::PlainObjectBase<derivedRetE>& retF); //return mesh faces
+
+//Same, with the solver state that is kept between calls on the same mesh owned by the caller.
+//scpSolver is only used when the cut leaves a single chart, several charts are flattened concurrently with a fresh solver each.
+template <typename derivedV, typename derivedF, typename derivedTTi, typename derivedE, typename derivedEMAP, typename indexType, typename cornerType, typename derivedCut, typename derivedRetV, typename derivedRetE>
 IGL_INLINE int flatten_cut(const Eigen::PlainObjectBase<derivedV>& V, //Vertices
-                           const Eigen::PlainObjectBase<derivedE>& F, //Faces
+                           const Eigen::PlainObjectBase<derivedF>& F, //Faces
                            const Eigen::PlainObjectBase<derivedE>& E, //Edges
-                           const Eigen::PlainObjectBase<derivedE>& edgesC, //EMAP
-                           const Eigen::PlainObjectBase<derivedE>& TT, //TT from triangle_triangle_adjacency
-                           const Eigen::PlainObjectBase<derivedE>& TTi, //TTi from triangle_triangle_adjacency
+                           const Eigen::PlainObjectBase<derivedEMAP>& edgesC, //EMAP
+                           const Eigen::PlainObjectBase<derivedF>& TT, //TT from triangle_triangle_adjacency
+                           const Eigen::PlainObjectBase<derivedTTi>& TTi, //TTi from triangle_triangle_adjacency
                            const std::vector<std::vector<indexType> >& VF, //VF from vertex_triangle_adjacency
-                           const std::vector<std::vector<indexType> >& VFi, //VFi from vertex_triangle_adjacency
+                           const std::vector<std::vector<cornerType> >& VFi, //VFi from vertex_triangle_adjacency
                            const std::vector<bool>& isB, //isB from is_border_vertex
                            const Eigen::PlainObjectBase<derivedCut>& cut, //indices to cut edges
+                           ScpSolver<typename derivedV::Scalar>& scpSolver, //Keeps the SCP factorization and eigenvector between calls, one per mesh
                            Eigen::PlainObjectBase<derivedRetV>& retV, //return mesh vertices
                            Eigen::PlainObjectBase<derivedRetE>& retF); //return mesh faces
 
 
 //Version that outputs error
 
-template <typename derivedV, typename derivedE, typename indexType, typename derivedCut, typename derivedRetV, typename derivedRetE, typename derivedRetErr>
+template <typename derivedV, typename derivedF, typename derivedTTi, typename derivedE, typename derivedEMAP, typename indexType, typename cornerType, typename derivedCut, typename derivedRetV, typename derivedRetE, typename derivedRetErr>
+IGL_INLINE int flatten_cut(const Eigen::PlainObjectBase<derivedV>& V, //Vertices
+                           const Eigen::PlainObjectBase<derivedF>& F, //Faces
+                           const Eigen::PlainObjectBase<derivedE>& E, //Edges
+                           const Eigen::PlainObjectBase<derivedEMAP>& edgesC, //EMAP
+                           const Eigen::PlainObjectBase<derivedF>& TT, //TT from triangle_triangle_adjacency
+                           const Eigen::PlainObjectBase<derivedTTi>& TTi, //TTi from triangle_triangle_adjacency
+                           const std::vector<std::vector<indexType> >& VF, //VF from vertex_triangle_adjacency
+                           const std::vector<std::vector<cornerType> >& VFi, //VFi from vertex_triangle_adjacency
+                           const std::vector<bool>& isB, //isB from is_border_vertex
+                           const Eigen::PlainObjectBase<derivedCut>& cut, //indices to cut edges
+                           Eigen::PlainObjectBase<derivedRetV>& retV, //return mesh vertices
+                           Eigen::PlainObjectBase<derivedRetE>& retF, //return mesh faces
+                           Eigen::PlainObjectBase<derivedRetErr>& error); //conformal error
+
+//Same, with the solver state that is kept between calls on the same mesh owned by the caller
+template <typename derivedV, typename derivedF, typename derivedTTi, typename derivedE, typename derivedEMAP, typename indexType, typename cornerType, typename derivedCut, typename derivedRetV, typename derivedRetE, typename derivedRetErr>
 IGL_INLINE int flatten_cut(const Eigen::PlainObjectBase<derivedV>& V, //Vertices
-                           const Eigen::PlainObjectBase<derivedE>& F, //Faces
+                           const Eigen::PlainObjectBase<derivedF>& F, //Faces
                            const Eigen::PlainObjectBase<derivedE>& E, //Edges
-                           const Eigen::PlainObjectBase<derivedE>& edgesC, //EMAP
-                           const Eigen::PlainObjectBase<derivedE>& TT, //TT from triangle_triangle_adjacency
-                           const Eigen::PlainObjectBase<derivedE>& TTi, //TTi from triangle_triangle_adjacency
+                           const Eigen::PlainObjectBase<derivedEMAP>& edgesC, //EMAP
+                           const Eigen::PlainObjectBase<derivedF>& TT, //TT from triangle_triangle_adjacency
+                           const Eigen::PlainObjectBase<derivedTTi>& TTi, //TTi from triangle_triangle_adjacency
                            const std::vector<std::vector<indexType> >& VF, //VF from vertex_triangle_adjacency
-                           const std::vector<std::vector<indexType> >& VFi, //VFi from vertex_triangle_adjacency
+                           const std::vector<std::vector<cornerType> >& VFi, //VFi from vertex_triangle_adjacency
                            const std::vector<bool>& isB, //isB from is_border_vertex
                            const Eigen::PlainObjectBase<derivedCut>& cut, //indices to cut edges
+                           ScpSolver<typename derivedV::Scalar>& scpSolver, //Keeps the SCP factorization and eigenvector between calls, one per mesh
                            Eigen::PlainObjectBase<derivedRetV>& retV, //return mesh vertices
                            Eigen::PlainObjectBase<derivedRetE>& retF, //return mesh faces
                            Eigen::PlainObjectBase<derivedRetErr>& error); //conformal error
 
 
+//Version that outputs all distortion metrics, see distortion_metrics
+
+template <typename derivedV, typename derivedF, typename derivedTTi, typename derivedE, typename derivedEMAP, typename indexType, typename cornerType, typename derivedCut, typename derivedRetV, typename derivedRetE, typename derivedRetErr, typename t_s>
+IGL_INLINE int flatten_cut(const Eigen::PlainObjectBase<derivedV>& V, //Vertices
+                           const Eigen::PlainObjectBase<derivedF>& F, //Faces
+                           const Eigen::PlainObjectBase<derivedE>& E, //Edges
+                           const Eigen::PlainObjectBase<derivedEMAP>& edgesC, //EMAP
+                           const Eigen::PlainObjectBase<derivedF>& TT, //TT from triangle_triangle_adjacency
+                           const Eigen::PlainObjectBase<derivedTTi>& TTi, //TTi from triangle_triangle_adjacency
+                           const std::vector<std::vector<indexType> >& VF, //VF from vertex_triangle_adjacency
+                           const std::vector<std::vector<cornerType> >& VFi, //VFi from vertex_triangle_adjacency
+                           const std::vector<bool>& isB, //isB from is_border_vertex
+                           const Eigen::PlainObjectBase<derivedCut>& cut, //indices to cut edges
+                           Eigen::PlainObjectBase<derivedRetV>& retV, //return mesh vertices
+                           Eigen::PlainObjectBase<derivedRetE>& retF, //return mesh faces
+                           Eigen::PlainObjectBase<derivedRetErr>& error, //conformal error
+                           Eigen::PlainObjectBase<derivedRetErr>& areaError, //area error
+                           Eigen::PlainObjectBase<derivedRetErr>& stretchError, //stretch error
+                           DistortionStats<t_s>& stats); //aggregates of the errors
+
+//Same, with the solver state that is kept between calls on the same mesh owned by the caller
+template <typename derivedV, typename derivedF, typename derivedTTi, typename derivedE, typename derivedEMAP, typename indexType, typename cornerType, typename derivedCut, typename derivedRetV, typename derivedRetE, typename derivedRetErr, typename t_s>
+IGL_INLINE int flatten_cut(const Eigen::PlainObjectBase<derivedV>& V, //Vertices
+                           const Eigen::PlainObjectBase<derivedF>& F, //Faces
+                           const Eigen::PlainObjectBase<derivedE>& E, //Edges
+                           const Eigen::PlainObjectBase<derivedEMAP>& edgesC, //EMAP
+                           const Eigen::PlainObjectBase<derivedF>& TT, //TT from triangle_triangle_adjacency
+                           const Eigen::PlainObjectBase<derivedTTi>& TTi, //TTi from triangle_triangle_adjacency
+                           const std::vector<std::vector<indexType> >& VF, //VF from vertex_triangle_adjacency
+                           const std::vector<std::vector<cornerType> >& VFi, //VFi from vertex_triangle_adjacency
+                           const std::vector<bool>& isB, //isB from is_border_vertex
+                           const Eigen::PlainObjectBase<derivedCut>& cut, //indices to cut edges
+                           ScpSolver<typename derivedV::Scalar>& scpSolver, //Keeps the SCP factorization and eigenvector between calls, one per mesh
+                           Eigen::PlainObjectBase<derivedRetV>& retV, //return mesh vertices
+                           Eigen::PlainObjectBase<derivedRetE>& retF, //return mesh faces
+                           Eigen::PlainObjectBase<derivedRetErr>& error, //conformal error
+                           Eigen::PlainObjectBase<derivedRetErr>& areaError, //area error
+                           Eigen::PlainObjectBase<derivedRetErr>& stretchError, //stretch error
+                           DistortionStats<t_s>& stats); //aggregates of the errors
+
+
 #ifndef IGL_STATIC_LIBRARY
 #  include "flatten_cut.cpp"
 #endif
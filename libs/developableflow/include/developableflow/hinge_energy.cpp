@@ -33,7 +33,7 @@
 #include <igl/per_vertex_normals.h>
 #include <igl/squared_edge_lengths.h>
 #include <igl/doublearea.h>
-#include <igl/parallel_for.h>
+#include <tools/thread_pool.h>
 
 #include <vector>
 #include <list>
@@ -43,29 +43,29 @@
 #include <Eigen/Sparse>
 
 
-template <typename derivedV, typename derivedF, typename indexType, typename derivedEnergy, typename derivedEnergyGrad>
+template <typename derivedV, typename derivedF, typename indexType, typename cornerType, typename derivedEnergy, typename derivedEnergyGrad>
 IGL_INLINE void hinge_energy_and_grad(
                                       const Eigen::PlainObjectBase<derivedV>& V,
                                       const Eigen::PlainObjectBase<derivedF>& F,
                                       const std::vector<std::vector<indexType> >& VF,
-                                      const std::vector<std::vector<indexType> >& VFi,
+                                      const std::vector<std::vector<cornerType> >& VFi,
                                       const std::vector<bool>& isB,
                                       Eigen::PlainObjectBase<derivedEnergy>& energy,
                                       Eigen::PlainObjectBase<derivedEnergyGrad>& energyGrad)
 {
     typedef typename derivedV::Scalar t_V_s;
-    typedef Eigen::Matrix<t_V_s, Eigen::Dynamic, 3> t_V;
+    typedef Eigen::Matrix<t_V_s, Eigen::Dynamic, 3, (derivedV::IsRowMajor ? Eigen::RowMajor : Eigen::ColMajor)> t_V;
     typedef Eigen::Matrix<t_V_s, Eigen::Dynamic, 1> t_Vv;
     typedef Eigen::SparseMatrix<t_V_s> t_Vs;
     typedef Eigen::Matrix<t_V_s, 3, 1> t_V3;
     typedef Eigen::Matrix<t_V_s, 1, 3> t_V3t;
     typedef Eigen::Matrix<t_V_s, 3, 3> t_V33;
     typedef typename derivedF::Scalar t_F_i;
-    typedef Eigen::Matrix<t_F_i, Eigen::Dynamic, 3> t_F;
+    typedef Eigen::Matrix<t_F_i, Eigen::Dynamic, 3, (derivedF::IsRowMajor ? Eigen::RowMajor : Eigen::ColMajor)> t_F;
     typedef typename derivedEnergy::Scalar t_energy_s;
     typedef Eigen::Matrix<t_energy_s, Eigen::Dynamic, 1> t_energy;
     typedef typename derivedEnergy::Scalar t_energyGrad_s;
-    typedef Eigen::Matrix<t_energyGrad_s, Eigen::Dynamic, 3> t_energyGrad;
+    typedef Eigen::Matrix<t_energyGrad_s, Eigen::Dynamic, 3, (derivedEnergyGrad::IsRowMajor ? Eigen::RowMajor : Eigen::ColMajor)> t_energyGrad;
     
     const t_V33 Id = t_V33::Identity();
     const auto macos = [] (const t_V_s& x)->t_V_s {
@@ -123,7 +123,7 @@ IGL_INLINE void hinge_energy_and_grad(
         
         const t_V3& Nv = vertexNormals.row(vert);
         const std::vector<indexType>& adjacentFaces = VF[vert];
-        const std::vector<indexType>& adjacentFacesi = VFi[vert];
+        const std::vector<cornerType>& adjacentFacesi = VFi[vert];
         
         t_V33 mat = t_V33::Zero();
         for(int f=0; f<adjacentFaces.size(); ++f) {
@@ -228,29 +228,29 @@ IGL_INLINE void hinge_energy_and_grad(
     accumulate(0);
 #else
     //PARALLEL VERSION
-    igl::parallel_for(V.rows(), prep_loop, handle_vertex, accumulate);
+    solver_parallel_for(V.rows(), prep_loop, handle_vertex, accumulate);
 #endif
     
 }
 
 
-template <typename derivedV, typename derivedF, typename indexType, typename derivedEnergy, typename derivedMinCurvatureDirs>
+template <typename derivedV, typename derivedF, typename indexType, typename cornerType, typename derivedEnergy, typename derivedMinCurvatureDirs>
 IGL_INLINE void hinge_energy(
                              const Eigen::PlainObjectBase<derivedV>& V,
                              const Eigen::PlainObjectBase<derivedF>& F,
                              const std::vector<std::vector<indexType> >& VF,
-                             const std::vector<std::vector<indexType> >& VFi,
+                             const std::vector<std::vector<cornerType> >& VFi,
                              const std::vector<bool>& isB,
                              Eigen::PlainObjectBase<derivedEnergy>& energy,
                              Eigen::PlainObjectBase<derivedMinCurvatureDirs>& minCurvatureDirs)
 {
     typedef typename derivedV::Scalar t_V_s;
-    typedef Eigen::Matrix<t_V_s, Eigen::Dynamic, 3> t_V;
+    typedef Eigen::Matrix<t_V_s, Eigen::Dynamic, 3, (derivedV::IsRowMajor ? Eigen::RowMajor : Eigen::ColMajor)> t_V;
     typedef Eigen::Matrix<t_V_s, Eigen::Dynamic, 1> t_Vv;
     typedef Eigen::Matrix<t_V_s, 3, 1> t_V3;
     typedef Eigen::Matrix<t_V_s, 3, 3> t_V33;
     typedef typename derivedF::Scalar t_F_i;
-    typedef Eigen::Matrix<t_F_i, Eigen::Dynamic, 3> t_F;
+    typedef Eigen::Matrix<t_F_i, Eigen::Dynamic, 3, (derivedF::IsRowMajor ? Eigen::RowMajor : Eigen::ColMajor)> t_F;
     typedef typename derivedEnergy::Scalar t_energy_s;
     typedef Eigen::Matrix<t_energy_s, Eigen::Dynamic, 1> t_energy;
     typedef typename derivedMinCurvatureDirs::Scalar t_mincurvaturedirs_s;
@@ -299,7 +299,7 @@ IGL_INLINE void hinge_energy(
             
             const t_V3& Nv = vertexNormals.row(vert);
             const std::vector<indexType>& adjacentFaces = VF[vert];
-            const std::vector<indexType>& adjacentFacesi = VFi[vert];
+            const std::vector<cornerType>& adjacentFacesi = VFi[vert];
             
             t_V33 mat = t_V33::Zero();
             for(int f=0; f<adjacentFaces.size(); ++f) {
@@ -334,21 +334,21 @@ IGL_INLINE void hinge_energy(
             handle_vertex(vert);
 #else
         //PARALLEL VERSION
-        igl::parallel_for(V.rows(), handle_vertex);
+        solver_parallel_for(V.rows(), handle_vertex);
 #endif
         
     }
     
     
-    template <typename derivedV, typename derivedF, typename indexType, typename derivedEnergy>
+    template <typename derivedV, typename derivedF, typename indexType, typename cornerType, typename derivedEnergy>
     IGL_INLINE void hinge_energy(
                                  const Eigen::PlainObjectBase<derivedV>& V,
                                  const Eigen::PlainObjectBase<derivedF>& F,
                                  const std::vector<std::vector<indexType> >& VF,
-                                 const std::vector<std::vector<indexType> >& VFi,
+                                 const std::vector<std::vector<cornerType> >& VFi,
                                  const std::vector<bool>& isB,
                                  Eigen::PlainObjectBase<derivedEnergy>& energy)
     {
-        Eigen::PlainObjectBase<derivedV> dummy;
+        derivedV dummy;
         hinge_energy(V, F, VF, VFi, isB, energy, dummy);
     }
@@ -40,12 +40,12 @@
 #undef WEIGH_BY_TIPANGLES
 #define NORMALIZE_BY_PAIRNUM
 
-template <typename derivedV, typename derivedF, typename indexType, typename derivedEnergy, typename derivedEnergyGrad>
+template <typename derivedV, typename derivedF, typename indexType, typename cornerType, typename derivedEnergy, typename derivedEnergyGrad>
 IGL_INLINE void hingepairs_energy_and_grad(
                                          const Eigen::PlainObjectBase<derivedV>& V,
                                          const Eigen::PlainObjectBase<derivedF>& F,
                                          const std::vector<std::vector<indexType> >& VF,
-                                         const std::vector<std::vector<indexType> >& VFi,
+                                         const std::vector<std::vector<cornerType> >& VFi,
                                          const std::vector<bool>& isB,
                                          Eigen::PlainObjectBase<derivedEnergy>& energy,
                                          Eigen::PlainObjectBase<derivedEnergyGrad>& energyGrad)
@@ -88,7 +88,7 @@ IGL_INLINE void hingepairs_energy_and_grad(
         t_V_s& currentEnergy = energy(vert);
         currentEnergy = INFTY;
         const std::vector<indexType>& adjacentFaces = VF[vert];
-        const std::vector<indexType>& adjacentFacesi = VFi[vert];
+        const std::vector<cornerType>& adjacentFacesi = VFi[vert];
         
         for(int edge1=0; edge1<adjacentFaces.size()-2; ++edge1) {
             for(int edge2=edge1+2; edge1==0 ? edge2<adjacentFaces.size()-1 : edge2<adjacentFaces.size(); ++edge2) {
@@ -185,7 +185,7 @@ IGL_INLINE void hingepairs_energy_and_grad(
         //    continue;
         
         const std::vector<indexType>& adjacentFaces = VF[vert];
-        const std::vector<indexType>& adjacentFacesi = VFi[vert];
+        const std::vector<cornerType>& adjacentFacesi = VFi[vert];
         const t_F_i& edge1 = partitionIndices(vert, 0);
         const t_F_i& edge2 = partitionIndices(vert, 1);
         const t_F_i& p1tipind = F(adjacentFaces[edge1],(adjacentFacesi[edge1]+1)%3);
@@ -321,12 +321,12 @@ IGL_INLINE void hingepairs_energy_and_grad(
 }
 
 
-template <typename derivedV, typename derivedF, typename indexType, typename derivedEnergy>
+template <typename derivedV, typename derivedF, typename indexType, typename cornerType, typename derivedEnergy>
 IGL_INLINE void hingepairs_energy(
                                 const Eigen::PlainObjectBase<derivedV>& V,
                                 const Eigen::PlainObjectBase<derivedF>& F,
                                 const std::vector<std::vector<indexType> >& VF,
-                                const std::vector<std::vector<indexType> >& VFi,
+                                const std::vector<std::vector<cornerType> >& VFi,
                                 const std::vector<bool>& isB,
                                 Eigen::PlainObjectBase<derivedEnergy>& energy)
 {
@@ -359,7 +359,7 @@ IGL_INLINE void hingepairs_energy(
         t_V_s& currentEnergy = energy(vert);
         currentEnergy = INFTY;
         const std::vector<indexType>& adjacentFaces = VF[vert];
-        const std::vector<indexType>& adjacentFacesi = VFi[vert];
+        const std::vector<cornerType>& adjacentFacesi = VFi[vert];
         
         for(int edge1=0; edge1<adjacentFaces.size()-2; ++edge1) {
             for(int edge2=edge1+2; edge1==0 ? edge2<adjacentFaces.size()-1 : edge2<adjacentFaces.size(); ++edge2) {
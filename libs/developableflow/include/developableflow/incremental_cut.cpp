@@ -0,0 +1,321 @@
+/*
+
+ 2018, Oded Stein, Eitan Grinspun and Keenan Crane
+
+ This file is part of the code for "Developability of Triangle Meshes".
+
+ The code for "Developability of Triangle Meshes" is free software: you can
+ redistribute it and/or modify it under the terms of the GNU General Public
+ License as published by the Free Software Foundation, either version 2 of the
+ License, or (at your option) any later version.
+
+ The code for "Developability of Triangle Meshes" is distributed in the hope
+ that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with the code for "Developability of Triangle Meshes". If not,
+ see <https://www.gnu.org/licenses/>.
+
+ */
+
+
+#include "incremental_cut.h"
+
+#include <tools/thread_pool.h>
+
+#include <set>
+#include <cmath>
+#include <limits>
+
+
+template <typename t_s, typename t_i>
+IGL_INLINE IncrementalCut<t_s, t_i>::IncrementalCut(const t_s& costTolerance) :
+tolerance(costTolerance), nRuns(0)
+{
+}
+
+
+template <typename t_s, typename t_i>
+IGL_INLINE void IncrementalCut<t_s, t_i>::reset()
+{
+    paths.clear();
+    referenceCosts.clear();
+    lastF.resize(0, 3);
+}
+
+
+template <typename t_s, typename t_i>
+IGL_INLINE t_i IncrementalCut<t_s, t_i>::last_runs() const
+{
+    return nRuns;
+}
+
+
+template <typename t_s, typename t_i>
+template <typename derivedV, typename derivedF, typename derivedEMAP, typename derivedDirs, typename derivedCut>
+IGL_INLINE int IncrementalCut<t_s, t_i>::update(const Eigen::PlainObjectBase<derivedV>& V,
+                                                const Eigen::PlainObjectBase<derivedF>& F,
+                                                const Eigen::PlainObjectBase<derivedEMAP>& edgesC,
+                                                const std::vector<bool>& isB,
+                                                const Eigen::PlainObjectBase<derivedDirs>& minCurvatureDirs,
+                                                const std::vector<t_i>& punctureList,
+                                                Eigen::PlainObjectBase<derivedCut>& cut)
+{
+    int retVal = 0;
+    nRuns = 0;
+
+    //Stored paths are only valid for the same connectivity
+    if(lastF.rows() != F.rows() || !(lastF == F.template cast<t_i>())) {
+        reset();
+        lastF = F.template cast<t_i>();
+    }
+
+    build_cut_graph(V, F, edgesC, isB, minCurvatureDirs, graph);
+    reverse_cut_graph(graph, reversed);
+
+    //Edges whose cost moved past the tolerance since the stored paths were computed.
+    //Halfedges that got cheaper can also shorten paths that do not cross them, they are checked below.
+    t_i nEdges = 0;
+    for(const t_i& e : graph.edges)
+        nEdges = std::max(nEdges, e+1);
+    std::vector<bool> edgeChanged(nEdges, false);
+    std::vector<t_i> cheaperHalfedges, cheaperTails;
+    if(referenceCosts.size() != graph.costs.size()) {
+        referenceCosts = graph.costs;
+    } else {
+        for(t_i u=0; u<graph.n_vertices(); ++u) {
+            for(t_i h=graph.offsets[u]; h<graph.offsets[u+1]; ++h) {
+                const t_s& oldCost = referenceCosts[h];
+                const t_s& newCost = graph.costs[h];
+                if(oldCost == newCost)
+                    continue;
+                if(!std::isfinite(oldCost) || !std::isfinite(newCost) || std::abs(newCost-oldCost) > tolerance*std::abs(oldCost)) {
+                    edgeChanged[graph.edges[h]] = true;
+                    if(newCost < oldCost) {
+                        cheaperHalfedges.push_back(h);
+                        cheaperTails.push_back(u);
+                    }
+                    referenceCosts[h] = newCost;
+                }
+            }
+        }
+    }
+
+    //Current puncture set, without duplicates
+    const std::set<t_i> punctureSet(punctureList.begin(), punctureList.end());
+    const std::vector<t_i> punctures(punctureSet.begin(), punctureSet.end());
+    const t_i npunctures = punctures.size();
+    std::vector<t_i> punctureIds(V.rows(), -1);
+    for(t_i i=0; i<npunctures; ++i)
+        punctureIds[punctures[i]] = i;
+
+    //Drop removed punctures
+    for(auto row=paths.begin(); row!=paths.end(); ) {
+        if(punctureSet.count(row->first) == 0) {
+            row = paths.erase(row);
+            continue;
+        }
+        for(auto entry=row->second.begin(); entry!=row->second.end(); ) {
+            if(punctureSet.count(entry->first) == 0)
+                entry = row->second.erase(entry);
+            else
+                ++entry;
+        }
+        ++row;
+    }
+
+    //Sources whose row has to be recomputed: new punctures, and punctures with a stored path over a changed edge
+    std::vector<t_i> dirtySources, newPunctures, cleanSources;
+    for(const t_i& p : punctures) {
+        auto row = paths.find(p);
+        if(row == paths.end()) {
+            newPunctures.push_back(p);
+            dirtySources.push_back(p);
+            continue;
+        }
+        bool dirty = false;
+        for(const auto& entry : row->second) {
+            for(const t_i& e : entry.second.edges)
+                if(edgeChanged[e]) {
+                    dirty = true;
+                    break;
+                }
+            if(dirty)
+                break;
+        }
+        if(dirty)
+            dirtySources.push_back(p);
+        else
+            cleanSources.push_back(p);
+    }
+
+    //A halfedge u->w that got cheaper makes the path from a to b obsolete if dist(a,u) + cost(u,w) + dist(w,b) is shorter.
+    //dist(.,u) and dist(w,.) to all punctures take one Dijkstra per endpoint. If that is more than recomputing the clean sources, recompute them.
+    if(!cheaperHalfedges.empty() && !cleanSources.empty()) {
+        std::vector<t_i> tailProbe(V.rows(), -1), headProbe(V.rows(), -1);
+        std::vector<t_i> probeVertices;
+        std::vector<bool> probeReversed;
+        for(t_i k=0; k<cheaperHalfedges.size(); ++k) {
+            const t_i& u = cheaperTails[k];
+            const t_i& w = graph.heads[cheaperHalfedges[k]];
+            if(tailProbe[u] < 0) {
+                tailProbe[u] = probeVertices.size();
+                probeVertices.push_back(u);
+                probeReversed.push_back(true);
+            }
+            if(headProbe[w] < 0) {
+                headProbe[w] = probeVertices.size();
+                probeVertices.push_back(w);
+                probeReversed.push_back(false);
+            }
+        }
+
+        std::vector<char> obsolete(cleanSources.size(), probeVertices.size() >= cleanSources.size());
+        if(probeVertices.size() < cleanSources.size()) {
+            //probeDistances[i][j] is dist(puncture j, probe i) for tails and dist(probe i, puncture j) for heads
+            std::vector<std::vector<t_s> > probeDistances(probeVertices.size(), std::vector<t_s>(npunctures));
+            std::vector<CutDijkstra<t_s, t_i> > forwardDijkstras, reverseDijkstras;
+            const auto prep_probes = [this, &forwardDijkstras, &reverseDijkstras] (const int& threadNum) {
+                forwardDijkstras.clear();
+                reverseDijkstras.clear();
+                forwardDijkstras.reserve(threadNum);
+                reverseDijkstras.reserve(threadNum);
+                for(int t=0; t<threadNum; ++t) {
+                    forwardDijkstras.emplace_back(graph);
+                    reverseDijkstras.emplace_back(reversed);
+                }
+            };
+            const auto handle_probe = [&] (const int& i, const int& thread) {
+                CutDijkstra<t_s, t_i>& dijkstra = probeReversed[i] ? reverseDijkstras[thread] : forwardDijkstras[thread];
+                dijkstra.run(probeVertices[i], punctureIds, npunctures);
+                for(t_i j=0; j<npunctures; ++j)
+                    probeDistances[i][j] = dijkstra.distance(punctures[j]);
+            };
+            const auto check_source = [&] (const int& i) {
+                const t_i& a = cleanSources[i];
+                const t_i& aId = punctureIds[a];
+                const std::map<t_i, Path>& row = paths.find(a)->second;
+                for(t_i k=0; k<cheaperHalfedges.size() && !obsolete[i]; ++k) {
+                    const t_s toTail = probeDistances[tailProbe[cheaperTails[k]]][aId] + graph.costs[cheaperHalfedges[k]];
+                    if(!std::isfinite(toTail))
+                        continue;
+                    const std::vector<t_s>& fromHead = probeDistances[headProbe[graph.heads[cheaperHalfedges[k]]]];
+                    for(const auto& entry : row)
+                        if(toTail + fromHead[punctureIds[entry.first]] < (1.-tolerance)*entry.second.length) {
+                            obsolete[i] = true;
+                            break;
+                        }
+                }
+            };
+
+#ifndef PARALLEL_COMPUTATION
+            //SERIAL VERSION
+            prep_probes(1);
+            for(int i=0; i<probeVertices.size(); ++i)
+                handle_probe(i, 0);
+            for(int i=0; i<cleanSources.size(); ++i)
+                check_source(i);
+#else
+            //PARALLEL VERSION
+            solver_parallel_for((int)probeVertices.size(), prep_probes, handle_probe, [] (const int&) {}, 2);
+            solver_parallel_for((int)cleanSources.size(), check_source);
+#endif
+            nRuns += probeVertices.size();
+        }
+
+        for(t_i i=0; i<cleanSources.size(); ++i)
+            if(obsolete[i])
+                dirtySources.push_back(cleanSources[i]);
+    }
+    for(const t_i& p : dirtySources)
+        paths[p].clear();
+
+    //Rows, one forward Dijkstra per dirty source. Every source only writes its own row.
+    std::vector<CutDijkstra<t_s, t_i> > dijkstras;
+    const auto prep_dijkstras = [this, &dijkstras] (const int& threadNum) {
+        dijkstras.clear();
+        dijkstras.reserve(threadNum);
+        for(int t=0; t<threadNum; ++t)
+            dijkstras.emplace_back(graph);
+    };
+    const auto handle_source = [&] (const int& i, const int& thread) {
+        CutDijkstra<t_s, t_i>& dijkstra = dijkstras[thread];
+        const t_i& a = dirtySources[i];
+        std::map<t_i, Path>& row = paths.find(a)->second;
+        dijkstra.run(a, punctureIds, npunctures);
+        for(const t_i& b : punctures) {
+            if(a == b)
+                continue;
+            Path& path = row[b];
+            path.length = dijkstra.distance(b);
+            path.edges.clear();
+            dijkstra.path_edges(b, path.edges);
+        }
+    };
+
+#ifndef PARALLEL_COMPUTATION
+    //SERIAL VERSION
+    prep_dijkstras(1);
+    for(int i=0; i<dirtySources.size(); ++i)
+        handle_source(i, 0);
+#else
+    //PARALLEL VERSION
+    solver_parallel_for((int)dirtySources.size(), prep_dijkstras, handle_source, [] (const int&) {}, 2);
+#endif
+    nRuns += dirtySources.size();
+
+    //Columns of the new punctures for all clean sources, one Dijkstra on the reversed graph per new puncture
+    if(newPunctures.size() < punctures.size()) {
+        std::set<t_i> dirtySet(dirtySources.begin(), dirtySources.end());
+        CutDijkstra<t_s, t_i> reverseDijkstra(reversed);
+        for(const t_i& b : newPunctures) {
+            reverseDijkstra.run(b, punctureIds, npunctures);
+            ++nRuns;
+            for(const t_i& a : punctures) {
+                if(a == b || dirtySet.count(a) > 0)
+                    continue;
+                Path& path = paths[a][b];
+                path.length = reverseDijkstra.distance(a);
+                path.edges.clear();
+                reverseDijkstra.path_edges(a, path.edges);
+            }
+        }
+    }
+
+    //Minimum spanning tree with Prim's algorithm on the dense puncture graph
+    std::set<t_i> cutEdges;
+    std::vector<t_s> pC(npunctures, std::numeric_limits<t_s>::infinity());
+    std::vector<t_i> pE(npunctures, -1);
+    std::vector<bool> inTree(npunctures, false);
+    for(t_i iter=0; iter<npunctures; ++iter) {
+        t_i v = -1;
+        for(t_i w=0; w<npunctures; ++w)
+            if(!inTree[w] && (v==-1 || pC[w] < pC[v]))
+                v = w;
+        inTree[v] = true;
+
+        if(pE[v] != -1) {
+            const Path& path = paths[punctures[pE[v]]][punctures[v]];
+            cutEdges.insert(path.edges.begin(), path.edges.end());
+        }
+
+        const std::map<t_i, Path>& row = paths[punctures[v]];
+        for(const auto& entry : row) {
+            const t_i& w = punctureIds[entry.first];
+            if(!inTree[w] && entry.second.length < pC[w]) {
+                pC[w] = entry.second.length;
+                pE[w] = v;
+            }
+        }
+    }
+
+    cut.resize(cutEdges.size());
+    int ind = 0;
+    for(const t_i& edge : cutEdges)
+        cut(ind++) = edge;
+
+
+    return retVal;
+}
@@ -0,0 +1,88 @@
+/*
+
+ 2018, Oded Stein, Eitan Grinspun and Keenan Crane
+
+ This file is part of the code for "Developability of Triangle Meshes".
+
+ The code for "Developability of Triangle Meshes" is free software: you can
+ redistribute it and/or modify it under the terms of the GNU General Public
+ License as published by the Free Software Foundation, either version 2 of the
+ License, or (at your option) any later version.
+
+ The code for "Developability of Triangle Meshes" is distributed in the hope
+ that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with the code for "Developability of Triangle Meshes". If not,
+ see <https://www.gnu.org/licenses/>.
+
+ */
+
+
+#ifndef DEVELOPABLEFLOW_INCREMENTAL_CUT_H
+#define DEVELOPABLEFLOW_INCREMENTAL_CUT_H
+
+#include <igl/igl_inline.h>
+
+#include <developableflow/cut_graph.h>
+
+#include <Eigen/Core>
+#include <vector>
+#include <map>
+
+
+//Relative change of a halfedge cost above which the shortest paths through it are recomputed
+#define CUT_COST_TOLERANCE 0.05
+
+
+//Stateful version of compute_cut_erickson for cuts that are recomputed while the flow runs.
+//Keeps the shortest path between every pair of punctures from the previous update and only reruns Dijkstra
+//for punctures that were added, whose stored paths cross an edge whose cost changed by more than the tolerance,
+//or whose paths could get shorter than (1-tolerance) of their stored length through an edge that got cheaper by more than the tolerance.
+//Costs that only drifted within the tolerance are not looked at, so a stored path is at most about a factor tolerance off.
+//A change in connectivity (F) drops all stored paths. The engine belongs to one mesh, use one per mesh and thread.
+template <typename t_s, typename t_i>
+class IncrementalCut
+{
+public:
+    IGL_INLINE IncrementalCut(const t_s& costTolerance = CUT_COST_TOLERANCE);
+
+    //Forget all stored paths, the next update starts from scratch
+    IGL_INLINE void reset();
+
+    //Returns 0 on success, error code otherwise
+    template <typename derivedV, typename derivedF, typename derivedEMAP, typename derivedDirs, typename derivedCut>
+    IGL_INLINE int update(const Eigen::PlainObjectBase<derivedV>& V, //Vertices
+                          const Eigen::PlainObjectBase<derivedF>& F, //Faces
+                          const Eigen::PlainObjectBase<derivedEMAP>& edgesC, //EMAP
+                          const std::vector<bool>& isB, //Is a vertex a bdry
+                          const Eigen::PlainObjectBase<derivedDirs>& minCurvatureDirs, //Per-vertex min curvature direction from hinge_energy
+                          const std::vector<t_i>& punctureList, //A list of the vertices that have to be included in the cuts
+                          Eigen::PlainObjectBase<derivedCut>& cut); //indices to cut edges return val
+
+    //Number of Dijkstra runs the last update needed
+    IGL_INLINE t_i last_runs() const;
+
+private:
+    struct Path {
+        t_s length;
+        std::vector<t_i> edges;
+    };
+
+    t_s tolerance;
+    CutGraph<t_s, t_i> graph, reversed;
+    std::vector<t_s> referenceCosts; //halfedge costs the stored paths were computed with
+    Eigen::Matrix<t_i, Eigen::Dynamic, 3> lastF; //connectivity the stored paths belong to
+    std::map<t_i, std::map<t_i, Path> > paths; //paths[a][b] is the shortest path from puncture vertex a to b
+    t_i nRuns;
+};
+
+
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "incremental_cut.cpp"
+#endif
+
+#endif
@@ -0,0 +1,307 @@
+/*
+ 
+ 2018, Oded Stein, Eitan Grinspun and Keenan Crane
+ 
+ This file is part of the code for "Developability of Triangle Meshes".
+ 
+ The code for "Developability of Triangle Meshes" is free software: you can
+ redistribute it and/or modify it under the terms of the GNU General Public
+ License as published by the Free Software Foundation, either version 2 of the
+ License, or (at your option) any later version.
+ 
+ The code for "Developability of Triangle Meshes" is distributed in the hope
+ that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with the code for "Developability of Triangle Meshes". If not,
+ see <https://www.gnu.org/licenses/>.
+ 
+ */
+
+
+#include "isotropic_remeshing.h"
+
+#include <igl/avg_edge_length.h>
+#include <igl/edge_flaps.h>
+#include <igl/collapse_edge.h>
+#include <igl/adjacency_list.h>
+#include <igl/is_border_vertex.h>
+#include <igl/per_vertex_normals.h>
+#include <tools/thread_pool.h>
+
+#include <iostream>
+#include <vector>
+#include <set>
+#include <utility>
+#include <algorithm>
+
+#define MAX_REMESHING_PASSES 8
+#define RELAXATION_WEIGHT 0.5
+
+
+template <typename derivedV, typename derivedF, typename derivedOrigV, typename derivedScalar>
+IGL_INLINE int isotropic_remeshing(
+                                   Eigen::PlainObjectBase<derivedV>& V,
+                                   Eigen::PlainObjectBase<derivedF>& F,
+                                   Eigen::PlainObjectBase<derivedOrigV>& origV,
+                                   const derivedScalar& targetEdgeLength,
+                                   const int& nIterations)
+{
+    typedef Eigen::Matrix<double, 1, 3> t_V3t;
+    typedef Eigen::Matrix<double, 3, 1> t_V3;
+    
+    assert(origV.rows() == V.rows() && "There must be an original position for every vertex.");
+    
+    int retVal = 0;
+    
+    //libigl's collapse_edge only works on these types
+    Eigen::MatrixXd dV = V.template cast<double>();
+    Eigen::MatrixXd dOrigV = origV.template cast<double>();
+    Eigen::MatrixXi dF = F.template cast<int>();
+    
+    const double L = targetEdgeLength > 0 ? (double) targetEdgeLength : igl::avg_edge_length(dV, dF);
+    const double high = 4./3.*L;
+    const double low = 4./5.*L;
+    
+    const auto edge_key = [] (int a, int b) {
+        return a<b ? std::make_pair(a, b) : std::make_pair(b, a);
+    };
+    
+    for(int iter=0; iter<nIterations; ++iter) {
+        int nSplits = 0, nCollapses = 0, nFlips = 0;
+        
+        //Split long edges. A face can only be split once per pass, the other long edges wait for the next pass
+        for(int pass=0; pass<MAX_REMESHING_PASSES; ++pass) {
+            Eigen::MatrixXi E, EF, EI;
+            Eigen::VectorXi EMAP;
+            igl::edge_flaps(dF, E, EMAP, EF, EI);
+            
+            std::vector<bool> faceTouched(dF.rows(), false);
+            std::vector<t_V3t> newVerts, newOrigVerts;
+            std::vector<Eigen::RowVector3i> newFaces;
+            for(int e=0; e<E.rows(); ++e) {
+                if((dV.row(E(e,0)) - dV.row(E(e,1))).norm() <= high)
+                    continue;
+                if((EF(e,0)>=0 && faceTouched[EF(e,0)]) || (EF(e,1)>=0 && faceTouched[EF(e,1)]))
+                    continue;
+                
+                const int m = dV.rows() + newVerts.size();
+                newVerts.push_back(0.5*(dV.row(E(e,0)) + dV.row(E(e,1))));
+                newOrigVerts.push_back(0.5*(dOrigV.row(E(e,0)) + dOrigV.row(E(e,1))));
+                
+                for(int k=0; k<2; ++k) {
+                    const int f = EF(e,k);
+                    if(f<0)
+                        continue;
+                    faceTouched[f] = true;
+                    
+                    //Face (o,a,b) becomes (o,a,m) and (o,m,b)
+                    const int c = EI(e,k);
+                    const int o = dF(f,c);
+                    const int b = dF(f,(c+2)%3);
+                    dF(f,(c+2)%3) = m;
+                    newFaces.push_back(Eigen::RowVector3i(o, m, b));
+                }
+                ++nSplits;
+            }
+            
+            if(newVerts.empty())
+                break;
+            
+            const int oldNV = dV.rows(), oldNF = dF.rows();
+            dV.conservativeResize(oldNV + newVerts.size(), 3);
+            dOrigV.conservativeResize(oldNV + newVerts.size(), 3);
+            for(int i=0; i<newVerts.size(); ++i) {
+                dV.row(oldNV+i) = newVerts[i];
+                dOrigV.row(oldNV+i) = newOrigVerts[i];
+            }
+            dF.conservativeResize(oldNF + newFaces.size(), 3);
+            for(int i=0; i<newFaces.size(); ++i)
+                dF.row(oldNF+i) = newFaces[i];
+        }
+        
+        //Collapse short edges to their midpoint, unless that would create a long edge or touch the boundary
+        for(int pass=0; pass<MAX_REMESHING_PASSES; ++pass) {
+            Eigen::MatrixXi E, EF, EI;
+            Eigen::VectorXi EMAP;
+            igl::edge_flaps(dF, E, EMAP, EF, EI);
+            const std::vector<bool> isB = igl::is_border_vertex(dV, dF);
+            std::vector<std::vector<int> > adjacency;
+            igl::adjacency_list(dF, adjacency);
+            
+            //Neighborhoods that changed in this pass are stale, they are handled in the next pass
+            std::vector<bool> locked(dV.rows(), false);
+            int passCollapses = 0;
+            for(int e=0; e<E.rows(); ++e) {
+                if(E(e,0) == IGL_COLLAPSE_EDGE_NULL && E(e,1) == IGL_COLLAPSE_EDGE_NULL)
+                    continue;
+                const int s = E(e,0), d = E(e,1);
+                if(isB[s] || isB[d] || locked[s] || locked[d])
+                    continue;
+                if((dV.row(s) - dV.row(d)).norm() >= low)
+                    continue;
+                
+                const t_V3t p = 0.5*(dV.row(s) + dV.row(d));
+                bool createsLongEdge = false;
+                for(const int& v : {s, d})
+                    for(const int& n : adjacency[v])
+                        if(n!=s && n!=d && (dV.row(n) - p).norm() > high)
+                            createsLongEdge = true;
+                if(createsLongEdge)
+                    continue;
+                
+                const t_V3t origP = 0.5*(dOrigV.row(s) + dOrigV.row(d));
+                if(igl::collapse_edge(e, p, dV, dF, E, EMAP, EF, EI)) {
+                    dOrigV.row(s) = origP;
+                    dOrigV.row(d) = origP;
+                    for(const int& v : {s, d}) {
+                        locked[v] = true;
+                        for(const int& n : adjacency[v])
+                            locked[n] = true;
+                    }
+                    ++passCollapses;
+                }
+            }
+            
+            if(passCollapses == 0)
+                break;
+            nCollapses += passCollapses;
+            
+            //Remove collapsed faces and unreferenced vertices, carrying origV along
+            int m = 0;
+            for(int f=0; f<dF.rows(); ++f)
+                if(dF(f,0) != IGL_COLLAPSE_EDGE_NULL || dF(f,1) != IGL_COLLAPSE_EDGE_NULL || dF(f,2) != IGL_COLLAPSE_EDGE_NULL)
+                    dF.row(m++) = dF.row(f);
+            dF.conservativeResize(m, 3);
+            
+            std::vector<int> newIndex(dV.rows(), -1);
+            for(int f=0; f<dF.rows(); ++f)
+                for(int j=0; j<3; ++j)
+                    newIndex[dF(f,j)] = 0;
+            int nV = 0;
+            for(int v=0; v<dV.rows(); ++v) {
+                if(newIndex[v] < 0)
+                    continue;
+                newIndex[v] = nV;
+                dV.row(nV) = dV.row(v);
+                dOrigV.row(nV) = dOrigV.row(v);
+                ++nV;
+            }
+            dV.conservativeResize(nV, 3);
+            dOrigV.conservativeResize(nV, 3);
+            for(int f=0; f<dF.rows(); ++f)
+                for(int j=0; j<3; ++j)
+                    dF(f,j) = newIndex[dF(f,j)];
+        }
+        
+        //Flip edges if that brings the valences closer to 6 (4 on the boundary)
+        {
+            Eigen::MatrixXi E, EF, EI;
+            Eigen::VectorXi EMAP;
+            igl::edge_flaps(dF, E, EMAP, EF, EI);
+            const std::vector<bool> isB = igl::is_border_vertex(dV, dF);
+            
+            std::vector<int> valence(dV.rows(), 0);
+            std::set<std::pair<int,int> > edgeSet;
+            for(int e=0; e<E.rows(); ++e) {
+                ++valence[E(e,0)];
+                ++valence[E(e,1)];
+                edgeSet.insert(edge_key(E(e,0), E(e,1)));
+            }
+            const auto deviation = [&isB, &valence] (const int& v, const int& change) {
+                return std::abs(valence[v] + change - (isB[v] ? 4 : 6));
+            };
+            
+            std::vector<bool> faceTouched(dF.rows(), false);
+            for(int e=0; e<E.rows(); ++e) {
+                const int f0 = EF(e,0), f1 = EF(e,1);
+                if(f0<0 || f1<0 || faceTouched[f0] || faceTouched[f1])
+                    continue;
+                
+                //f0 = (o0,a,b), f1 = (o1,b,a)
+                const int c0 = EI(e,0), c1 = EI(e,1);
+                const int o0 = dF(f0,c0), a = dF(f0,(c0+1)%3), b = dF(f0,(c0+2)%3);
+                const int o1 = dF(f1,c1);
+                if(o0==o1 || valence[a]<=3 || valence[b]<=3 || edgeSet.count(edge_key(o0, o1)))
+                    continue;
+                
+                const int before = deviation(a,0) + deviation(b,0) + deviation(o0,0) + deviation(o1,0);
+                const int after = deviation(a,-1) + deviation(b,-1) + deviation(o0,1) + deviation(o1,1);
+                if(after >= before)
+                    continue;
+                
+                //Do not flip if one of the new triangles would fold over
+                const t_V3 pa = dV.row(a).transpose(), pb = dV.row(b).transpose();
+                const t_V3 po0 = dV.row(o0).transpose(), po1 = dV.row(o1).transpose();
+                const t_V3 oldN = (pa-po0).cross(pb-po0) + (pb-po1).cross(pa-po1);
+                const t_V3 newN0 = (pa-po0).cross(po1-po0);
+                const t_V3 newN1 = (pb-po1).cross(po0-po1);
+                if(newN0.dot(oldN) <= 0 || newN1.dot(oldN) <= 0)
+                    continue;
+                
+                dF.row(f0) << o0, a, o1;
+                dF.row(f1) << o1, b, o0;
+                faceTouched[f0] = true;
+                faceTouched[f1] = true;
+                --valence[a];
+                --valence[b];
+                ++valence[o0];
+                ++valence[o1];
+                edgeSet.erase(edge_key(a, b));
+                edgeSet.insert(edge_key(o0, o1));
+                ++nFlips;
+            }
+        }
+        
+        //Tangential relaxation towards the centroid of the 1-ring. origV gets the same update without the projection
+        {
+            const std::vector<bool> isB = igl::is_border_vertex(dV, dF);
+            std::vector<std::vector<int> > adjacency;
+            igl::adjacency_list(dF, adjacency);
+            Eigen::MatrixXd N;
+            igl::per_vertex_normals(dV, dF, N);
+            
+            Eigen::MatrixXd newV = dV, newOrigV = dOrigV;
+            const auto relax_vertex = [&] (const int& v) {
+                if(isB[v] || adjacency[v].empty())
+                    return;
+                t_V3t c = t_V3t::Zero(), origC = t_V3t::Zero();
+                for(const int& n : adjacency[v]) {
+                    c += dV.row(n);
+                    origC += dOrigV.row(n);
+                }
+                c /= (double) adjacency[v].size();
+                origC /= (double) adjacency[v].size();
+                
+                const t_V3t n = N.row(v);
+                t_V3t u = c - dV.row(v);
+                u -= u.dot(n)*n;
+                newV.row(v) += RELAXATION_WEIGHT*u;
+                newOrigV.row(v) += RELAXATION_WEIGHT*(origC - dOrigV.row(v));
+            };
+            
+#ifndef PARALLEL_COMPUTATION
+            //SERIAL VERSION
+            for(int v=0; v<dV.rows(); ++v)
+                relax_vertex(v);
+#else
+            //PARALLEL VERSION
+            solver_parallel_for(dV.rows(), relax_vertex);
+#endif
+            dV.swap(newV);
+            dOrigV.swap(newOrigV);
+        }
+        
+        std::cout << "Isotropic remeshing: " << nSplits << " edges split, " << nCollapses << " edges collapsed, " << nFlips << " edges flipped." << std::endl;
+        if(nSplits>0 || nCollapses>0 || nFlips>0)
+            retVal = 1;
+    }
+    
+    V = dV.template cast<typename derivedV::Scalar>();
+    origV = dOrigV.template cast<typename derivedOrigV::Scalar>();
+    F = dF.template cast<typename derivedF::Scalar>();
+    
+    return retVal;
+}
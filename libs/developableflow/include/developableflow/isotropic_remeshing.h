@@ -0,0 +1,52 @@
+/*
+ 
+ 2018, Oded Stein, Eitan Grinspun and Keenan Crane
+ 
+ This file is part of the code for "Developability of Triangle Meshes".
+ 
+ The code for "Developability of Triangle Meshes" is free software: you can
+ redistribute it and/or modify it under the terms of the GNU General Public
+ License as published by the Free Software Foundation, either version 2 of the
+ License, or (at your option) any later version.
+ 
+ The code for "Developability of Triangle Meshes" is distributed in the hope
+ that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with the code for "Developability of Triangle Meshes". If not,
+ see <https://www.gnu.org/licenses/>.
+ 
+ */
+
+
+#ifndef DEVELOPABLEFLOW_ISOTROPIC_REMESHING_H
+#define DEVELOPABLEFLOW_ISOTROPIC_REMESHING_H
+
+#include <igl/igl_inline.h>
+
+#include <Eigen/Core>
+
+//Isotropic remeshing towards a target edge length (Botsch and Kobbelt 2004): split long edges, collapse short edges,
+//flip edges to even out valences and relax vertices tangentially. Boundary vertices are kept in place.
+//Meant to be run every few steps of the flow so element quality does not degrade. origV has one row per vertex of V and is
+//interpolated along with V, so correspondences to the original mesh are carried through.
+//Returns 0 if F did not change, returns 1 if a change to F happened. V always moves, so cached energies and search directions are stale afterwards.
+
+
+template <typename derivedV, typename derivedF, typename derivedOrigV, typename derivedScalar>
+IGL_INLINE int isotropic_remeshing(
+                                   Eigen::PlainObjectBase<derivedV>& V, //Vertices
+                                   Eigen::PlainObjectBase<derivedF>& F, //Faces
+                                   Eigen::PlainObjectBase<derivedOrigV>& origV, //Original position of each vertex
+                                   const derivedScalar& targetEdgeLength = 0, //Target edge length, the average edge length is used if <= 0
+                                   const int& nIterations = 1); //How many split-collapse-flip-relax iterations to do
+
+
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "isotropic_remeshing.cpp"
+#endif
+
+#endif
@@ -24,6 +24,7 @@
 #include "max_hinge_energy.h"
 
 #include <tools/kopp.h>
+#include <tools/thread_pool.h>
 
 #include <igl/doublearea.h>
 #include <igl/internal_angles.h>
@@ -36,12 +37,12 @@
 
 #undef HINGE_SAMPLE_MIDARCS
 
-template <typename derivedV, typename derivedF, typename indexType, typename derivedEnergy, typename derivedEnergyGrad>
+template <typename derivedV, typename derivedF, typename indexType, typename cornerType, typename derivedEnergy, typename derivedEnergyGrad>
 IGL_INLINE void max_hinge_energy_and_grad(
                                           const Eigen::PlainObjectBase<derivedV>& V,
                                           const Eigen::PlainObjectBase<derivedF>& F,
                                           const std::vector<std::vector<indexType> >& VF,
-                                          const std::vector<std::vector<indexType> >& VFi,
+                                          const std::vector<std::vector<cornerType> >& VFi,
                                           const std::vector<bool>& isB,
                                           Eigen::PlainObjectBase<derivedEnergy>& energy,
                                           Eigen::PlainObjectBase<derivedEnergyGrad>& energyGrad)
@@ -167,7 +168,7 @@ IGL_INLINE void max_hinge_energy_and_grad(
         handle_vertex_energy(vert);
 #else
     //PARALLEL VERSION
-    igl::parallel_for(V.rows(), handle_vertex_energy);
+    solver_parallel_for(V.rows(), handle_vertex_energy);
 #endif
     
     
@@ -199,7 +200,7 @@ IGL_INLINE void max_hinge_energy_and_grad(
         
         const t_V3& Nv = vertexNormals.row(vert);
         const std::vector<indexType>& adjacentFaces = VF[vert];
-        const std::vector<indexType>& adjacentFacesi = VFi[vert];
+        const std::vector<cornerType>& adjacentFacesi = VFi[vert];
         
         const int& facei = adjacentFaces[normalIndices(vert,0)], &facej = adjacentFaces[normalIndices(vert,1)], &facek1 = adjacentFaces[maxIndices(vert,0)], &facek2 = adjacentFaces[maxIndices(vert,1)];
         const t_V3& Nfi = faceNormals.row(facei), &Nfj = faceNormals.row(facej), &Nfk1 = faceNormals.row(facek1), &Nfk2 = faceNormals.row(facek2);
@@ -290,18 +291,18 @@ IGL_INLINE void max_hinge_energy_and_grad(
     accumulate(0);
 #else
     //PARALLEL VERSION
-    igl::parallel_for(V.rows(), prep_loop, handle_vertex_grad, accumulate);
+    solver_parallel_for(V.rows(), prep_loop, handle_vertex_grad, accumulate);
 #endif
     
 }
 
 
-template <typename derivedV, typename derivedF, typename indexType, typename derivedEnergy>
+template <typename derivedV, typename derivedF, typename indexType, typename cornerType, typename derivedEnergy>
 IGL_INLINE void max_hinge_energy(
                                  const Eigen::PlainObjectBase<derivedV>& V,
                                  const Eigen::PlainObjectBase<derivedF>& F,
                                  const std::vector<std::vector<indexType> >& VF,
-                                 const std::vector<std::vector<indexType> >& VFi,
+                                 const std::vector<std::vector<cornerType> >& VFi,
                                  const std::vector<bool>& isB,
                                  Eigen::PlainObjectBase<derivedEnergy>& energy)
 {
@@ -353,9 +354,9 @@ IGL_INLINE void max_hinge_energy(
     const auto handle_vertex_energy = [&] (const t_F_i& vert) {
         //Boundary vertices contribute no energy
 #ifdef IGNORE_VALENCE_3
-        if(isB[vert] || 1.+energy(vert)==1. || VF[vert].size()<4) {
+        if(isB[vert] || VF[vert].size()<4) {
 #else
-        if(isB[vert] || 1.+energy(vert)==1.) {
+        if(isB[vert]) {
 #endif
             energy(vert) = 0;
             return;
@@ -372,8 +373,8 @@ IGL_INLINE void max_hinge_energy(
             //if(1.+Nv.cross(Nfi).norm()==1. || 1.+Nv.cross(Nfj).norm()==1.)
             if(Nv.cross(Nfi).norm() < 1e-6 || Nv.cross(Nfj).norm() < 1e-6)
                 return;
-            const t_V3 Nfwi = signi*Nv.cross(Nfi).cross(Nv).normalized()*macos(Nv.cross(Nfi));
-            const t_V3 Nfwj = signj*Nv.cross(Nfj).cross(Nv).normalized()*macos(Nv.cross(Nfj));
+            const t_V3 Nfwi = signi*Nv.cross(Nfi).cross(Nv).normalized()*macos(Nv.dot(Nfi));
+            const t_V3 Nfwj = signj*Nv.cross(Nfj).cross(Nv).normalized()*macos(Nv.dot(Nfj));
             const t_V3 base = Nfwi-Nfwj;
             //if(1.+base.norm()==1.)
             if(base.norm() < 1e-6)
@@ -384,10 +385,10 @@ IGL_INLINE void max_hinge_energy(
             t_V_s localEnergy = -1;
             for(int k1=0; k1<adjacentFaces.size(); ++k1) {
                 const t_V3& Nfk1 = faceNormals.row(adjacentFaces[k1]);
-                const t_V3 Nfwk1 = 1.+Nv.cross(Nfk1).norm()==1. ? t_V3::Zero() : (Nv.cross(Nfk1).cross(Nv).normalized()*macos(Nv.cross(Nfk1))).eval();
+                const t_V3 Nfwk1 = 1.+Nv.cross(Nfk1).norm()==1. ? t_V3::Zero() : (Nv.cross(Nfk1).cross(Nv).normalized()*macos(Nv.dot(Nfk1))).eval();
                 for(int k2=k1; k2<adjacentFaces.size(); ++k2) {
                     const t_V3& Nfk2 = faceNormals.row(adjacentFaces[k2]);
-                    const t_V3 Nfwk2 = 1.+Nv.cross(Nfk2).norm()==1. ? t_V3::Zero() : (Nv.cross(Nfk2).cross(Nv).normalized()*macos(Nv.cross(Nfk2))).eval();
+                    const t_V3 Nfwk2 = 1.+Nv.cross(Nfk2).norm()==1. ? t_V3::Zero() : (Nv.cross(Nfk2).cross(Nv).normalized()*macos(Nv.dot(Nfk2))).eval();
                     const t_V_s udN = u.dot(Nfwk1-Nfwk2);
                     if(localEnergy < udN*udN) {
                         localEnergy = udN*udN;
@@ -423,7 +424,7 @@ IGL_INLINE void max_hinge_energy(
         handle_vertex_energy(vert);
 #else
     //PARALLEL VERSION
-    igl::parallel_for(V.rows(), handle_vertex_energy);
+    solver_parallel_for(V.rows(), handle_vertex_energy);
 #endif
     
 }
@@ -29,23 +29,23 @@
 #include <Eigen/Core>
 #include <vector>
 
-template <typename derivedV, typename derivedF, typename indexType, typename derivedEnergy, typename derivedEnergyGrad>
+template <typename derivedV, typename derivedF, typename indexType, typename cornerType, typename derivedEnergy, typename derivedEnergyGrad>
 IGL_INLINE void max_hinge_energy_and_grad(
                                       const Eigen::PlainObjectBase<derivedV>& V, //Vertices
                                       const Eigen::PlainObjectBase<derivedF>& F, //TT from triangle_triangle_adjacency
                                       const std::vector<std::vector<indexType> >& VF, //VF from vertex-triangle adjacency
-                                      const std::vector<std::vector<indexType> >& VFi, //VFi from vertex-triangle adjacency
+                                      const std::vector<std::vector<cornerType> >& VFi, //VFi from vertex-triangle adjacency
                                       const std::vector<bool>& isB, //isB from is_border_vertex
                                       Eigen::PlainObjectBase<derivedEnergy>& energy, //energy return val
                                       Eigen::PlainObjectBase<derivedEnergyGrad>& energyGrad); //energy grad return val
 
 
-template <typename derivedV, typename derivedF, typename indexType, typename derivedEnergy>
+template <typename derivedV, typename derivedF, typename indexType, typename cornerType, typename derivedEnergy>
 IGL_INLINE void max_hinge_energy(
                              const Eigen::PlainObjectBase<derivedV>& V, //Vertices
                              const Eigen::PlainObjectBase<derivedF>& F, //TT from triangle_triangle_adjacency
                              const std::vector<std::vector<indexType> >& VF, //VF from vertex-triangle adjacency
-                             const std::vector<std::vector<indexType> >& VFi, //VFi from vertex-triangle adjacency
+                             const std::vector<std::vector<cornerType> >& VFi, //VFi from vertex-triangle adjacency
                              const std::vector<bool>& isB, //isB from is_border_vertex
                              Eigen::PlainObjectBase<derivedEnergy>& energy); //energy return val
 
@@ -39,12 +39,12 @@
 #undef TWOSIDES_MAXIMUM
 
 
-template <typename derivedV, typename derivedF, typename indexType, typename derivedEnergy, typename derivedEnergyGrad>
+template <typename derivedV, typename derivedF, typename indexType, typename cornerType, typename derivedEnergy, typename derivedEnergyGrad>
 IGL_INLINE void maxhingepairs_energy_and_grad(
                                               const Eigen::PlainObjectBase<derivedV>& V,
                                               const Eigen::PlainObjectBase<derivedF>& F,
                                               const std::vector<std::vector<indexType> >& VF,
-                                              const std::vector<std::vector<indexType> >& VFi,
+                                              const std::vector<std::vector<cornerType> >& VFi,
                                               const std::vector<bool>& isB,
                                               Eigen::PlainObjectBase<derivedEnergy>& energy,
                                               Eigen::PlainObjectBase<derivedEnergyGrad>& energyGrad)
@@ -161,7 +161,7 @@ IGL_INLINE void maxhingepairs_energy_and_grad(
             continue;
         
         const std::vector<indexType>& adjacentFaces = VF[vert];
-        const std::vector<indexType>& adjacentFacesi = VFi[vert];
+        const std::vector<cornerType>& adjacentFacesi = VFi[vert];
         
         const auto process_gradient = [&] (const t_ind& maxNormInd) {
             const t_F_i& n1 = maxNormInd(vert, 0);
@@ -218,12 +218,12 @@ IGL_INLINE void maxhingepairs_energy_and_grad(
 }
 
 
-template <typename derivedV, typename derivedF, typename indexType, typename derivedEnergy, typename derivedMinCurvatureDirs>
+template <typename derivedV, typename derivedF, typename indexType, typename cornerType, typename derivedEnergy, typename derivedMinCurvatureDirs>
 IGL_INLINE void maxhingepairs_energy(
                                      const Eigen::PlainObjectBase<derivedV>& V,
                                      const Eigen::PlainObjectBase<derivedF>& F,
                                      const std::vector<std::vector<indexType> >& VF,
-                                     const std::vector<std::vector<indexType> >& VFi,
+                                     const std::vector<std::vector<cornerType> >& VFi,
                                      const std::vector<bool>& isB,
                                      Eigen::PlainObjectBase<derivedEnergy>& energy,
                                      Eigen::PlainObjectBase<derivedMinCurvatureDirs>& minCurvatureDirs)
@@ -314,3 +314,17 @@ IGL_INLINE void maxhingepairs_energy(
     
     
 }
+
+
+template <typename derivedV, typename derivedF, typename indexType, typename cornerType, typename derivedEnergy>
+IGL_INLINE void maxhingepairs_energy(
+                                     const Eigen::PlainObjectBase<derivedV>& V,
+                                     const Eigen::PlainObjectBase<derivedF>& F,
+                                     const std::vector<std::vector<indexType> >& VF,
+                                     const std::vector<std::vector<cornerType> >& VFi,
+                                     const std::vector<bool>& isB,
+                                     Eigen::PlainObjectBase<derivedEnergy>& energy)
+{
+    derivedV dummy;
+    maxhingepairs_energy(V, F, VF, VFi, isB, energy, dummy);
+}
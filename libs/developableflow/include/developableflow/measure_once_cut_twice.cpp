@@ -26,6 +26,9 @@
 #include <developableflow/compute_cut.h>
 #include <developableflow/flatten_cut.h>
 #include <developableflow/hinge_energy.h>
+#include <developableflow/incremental_cut.h>
+#include <developableflow/select_punctures.h>
+#include <tools/pack_charts.h>
 
 #include <igl/doublearea.h>
 #include <igl/edge_lengths.h>
@@ -35,74 +38,120 @@
 
 #include <vector>
 #include <set>
+#include <cmath>
 
 #include <Eigen/Core>
 #include <Eigen/Sparse>
 #include <Eigen/SparseCholesky>
 
 #define CUT_PERCENTAGE 0.1 //0.95
+#define PUNCTURE_TOP_K 0 //At most this many punctures, 0 for no limit
+#define PUNCTURE_SPACING 0. //Minimum distance between punctures relative to the bounding box diagonal, 0 for no thinning
 #define CLOSE_VERTEX_THRESHOLD 0.0005
 #define ERROR_TOO_LARGE 1.3
+#define PACK_SHEET_WIDTH 0. //Width of the sheet the charts are packed on, relative to the square root of the surface area. 0 for a roughly square sheet, negative to not pack.
+#define PACK_SPACING 0.01 //Gap between packed charts, relative to the square root of the surface area
 
 #define MEASUREONCE
 
+//How the punctures are connected into a cut
+#define CUT_ERICKSON 1 //Dijkstra from every puncture, MST on the complete puncture graph
+#define CUT_VORONOI 2 //One multi-source Dijkstra, MST on the Voronoi neighbors only
+#define CUT_INCREMENTAL 3 //Like CUT_ERICKSON, but keeps the paths between calls and only recomputes what changed
+#ifndef CUT_METHOD
+#define CUT_METHOD CUT_ERICKSON //The reference cut, define CUT_METHOD as CUT_VORONOI or CUT_INCREMENTAL to opt in
+#endif
+
 #define INFTY std::numeric_limits<double>::infinity()
 
 
 
-template <typename derivedV, typename derivedE, typename indexType, typename thresholdType, typename derivedCut, typename derivedRetV, typename derivedRetE, typename derivedRetErr>
+template <typename derivedV, typename derivedF, typename derivedTTi, typename derivedE, typename derivedEMAP, typename indexType, typename cornerType, typename thresholdType, typename derivedCut, typename derivedRetV, typename derivedRetE, typename derivedRetErr>
 IGL_INLINE void measure_once_cut_twice(const Eigen::PlainObjectBase<derivedV>& V,
-                                       const Eigen::PlainObjectBase<derivedE>& F,
+                                       const Eigen::PlainObjectBase<derivedF>& F,
                                        const Eigen::PlainObjectBase<derivedE>& E,
-                                       const Eigen::PlainObjectBase<derivedE>& edgesC,
-                                       const Eigen::PlainObjectBase<derivedE>& TT,
-                                       const Eigen::PlainObjectBase<derivedE>& TTi,
+                                       const Eigen::PlainObjectBase<derivedEMAP>& edgesC,
+                                       const Eigen::PlainObjectBase<derivedF>& TT,
+                                       const Eigen::PlainObjectBase<derivedTTi>& TTi,
                                        const std::vector<std::vector<indexType> >& VF,
-                                       const std::vector<std::vector<indexType> >& VFi,
+                                       const std::vector<std::vector<cornerType> >& VFi,
                                        const std::vector<bool>& isB,
                                        const thresholdType& cutThreshold,
                                        Eigen::PlainObjectBase<derivedCut>& cut,
                                        Eigen::PlainObjectBase<derivedRetV>& retV,
                                        Eigen::PlainObjectBase<derivedRetE>& retF,
                                        Eigen::PlainObjectBase<derivedRetErr>& error)
+{
+    //No state between calls, every call starts from scratch
+    IncrementalCut<typename derivedV::Scalar, typename derivedE::Scalar> incrementalCut;
+    ScpSolver<typename derivedV::Scalar> scpSolver;
+    measure_once_cut_twice(V, F, E, edgesC, TT, TTi, VF, VFi, isB, cutThreshold, incrementalCut, scpSolver, cut, retV, retF, error);
+}
+
+
+template <typename derivedV, typename derivedF, typename derivedTTi, typename derivedE, typename derivedEMAP, typename indexType, typename cornerType, typename thresholdType, typename derivedCut, typename derivedRetV, typename derivedRetE, typename derivedRetErr>
+IGL_INLINE void measure_once_cut_twice(const Eigen::PlainObjectBase<derivedV>& V,
+                                       const Eigen::PlainObjectBase<derivedF>& F,
+                                       const Eigen::PlainObjectBase<derivedE>& E,
+                                       const Eigen::PlainObjectBase<derivedEMAP>& edgesC,
+                                       const Eigen::PlainObjectBase<derivedF>& TT,
+                                       const Eigen::PlainObjectBase<derivedTTi>& TTi,
+                                       const std::vector<std::vector<indexType> >& VF,
+                                       const std::vector<std::vector<cornerType> >& VFi,
+                                       const std::vector<bool>& isB,
+                                       const thresholdType& cutThreshold,
+                                       IncrementalCut<typename derivedV::Scalar, typename derivedE::Scalar>& incrementalCut,
+                                       ScpSolver<typename derivedV::Scalar>& scpSolver,
+                                       Eigen::PlainObjectBase<derivedCut>& cut,
+                                       Eigen::PlainObjectBase<derivedRetV>& retV,
+                                       Eigen::PlainObjectBase<derivedRetE>& retF,
+                                       Eigen::PlainObjectBase<derivedRetErr>& error)
 {
     typedef typename derivedV::Scalar t_V_s;
-    typedef Eigen::Matrix<t_V_s, Eigen::Dynamic, 3> t_V;
+    typedef Eigen::Matrix<t_V_s, Eigen::Dynamic, 3, (derivedV::IsRowMajor ? Eigen::RowMajor : Eigen::ColMajor)> t_V;
     typedef Eigen::Matrix<t_V_s, 3, 1> t_V3;
     typedef Eigen::Matrix<t_V_s, Eigen::Dynamic, 1> t_Vv;
     typedef typename derivedE::Scalar t_E_i;
-    typedef Eigen::Matrix<t_E_i, Eigen::Dynamic, 2> t_E;
+    typedef Eigen::Matrix<t_E_i, Eigen::Dynamic, 2, (derivedE::IsRowMajor ? Eigen::RowMajor : Eigen::ColMajor)> t_E;
     typedef Eigen::Matrix<t_E_i, 1, 2> t_E2;
-    typedef Eigen::Matrix<t_E_i, Eigen::Dynamic, 3> t_F;
+    typedef Eigen::Matrix<t_E_i, Eigen::Dynamic, 3, (derivedF::IsRowMajor ? Eigen::RowMajor : Eigen::ColMajor)> t_F;
     typedef Eigen::Matrix<t_E_i, Eigen::Dynamic, 1> t_Fv;
     typedef Eigen::Matrix<bool, Eigen::Dynamic, 1> t_Ebool;
     typedef typename derivedRetV::Scalar t_retV_s;
-    typedef Eigen::Matrix<t_retV_s, Eigen::Dynamic, 3> t_retV;
+    typedef Eigen::Matrix<t_retV_s, Eigen::Dynamic, 3, (derivedRetV::IsRowMajor ? Eigen::RowMajor : Eigen::ColMajor)> t_retV;
     typedef typename derivedRetE::Scalar t_retE_i;
-    typedef Eigen::Matrix<t_retE_i, Eigen::Dynamic, 3> t_retF;
+    typedef Eigen::Matrix<t_retE_i, Eigen::Dynamic, 3, (derivedRetE::IsRowMajor ? Eigen::RowMajor : Eigen::ColMajor)> t_retF;
     typedef typename derivedCut::Scalar t_derivedCut_i;
     typedef Eigen::Matrix<t_derivedCut_i, Eigen::Dynamic, 1> t_derivedCut;
     
     
     //Compute hinge energy (for cost analysis)
     t_Vv hingeEnergy;
+#if CUT_METHOD == CUT_INCREMENTAL
+    //The min curvature directions are reused for the cut costs, the caller's engine keeps the paths between calls
+    t_V minCurvatureVecs;
+    hinge_energy(V, F, VF, VFi, isB, hingeEnergy, minCurvatureVecs);
+#else
     hinge_energy(V, F, VF, VFi, isB, hingeEnergy);
-    
-    //Sort by energy
-    std::vector<std::pair<t_V_s, t_E_i> > costVector;
-    costVector.reserve(V.rows());
-    for(int vert=0; vert<V.rows(); ++vert)
-        costVector.push_back(std::make_pair(hingeEnergy(vert), vert));
-    std::sort(costVector.begin(), costVector.end());
+#endif
     
     //Build puncture list
+    PunctureSelection<t_V_s> selection;
+    selection.percentile = CUT_PERCENTAGE;
+    selection.topK = PUNCTURE_TOP_K;
+    selection.threshold = cutThreshold;
+    selection.spacing = PUNCTURE_SPACING;
     std::vector<t_E_i> punctureList;
-    for(int v=floor(CUT_PERCENTAGE*V.rows()); v<V.rows(); ++v)
-        if(costVector[v].first > cutThreshold)
-            punctureList.push_back(costVector[v].second);
+    select_punctures(V, hingeEnergy, selection, punctureList);
     
+#if CUT_METHOD == CUT_INCREMENTAL
+    incrementalCut.update(V, F, edgesC, isB, minCurvatureVecs, punctureList, cut);
+#elif CUT_METHOD == CUT_VORONOI
+    compute_cut_voronoi(V, F, E, edgesC, TT, TTi, VF, VFi, isB, punctureList, cut);
+#else
     compute_cut_erickson(V, F, E, edgesC, TT, TTi, VF, VFi, isB, punctureList, cut);
-    flatten_cut(V, F, E, edgesC, TT, TTi, VF, VFi, isB, cut, retV, retF, error);
+#endif
+    flatten_cut(V, F, E, edgesC, TT, TTi, VF, VFi, isB, cut, scpSolver, retV, retF, error);
     
 #ifndef MEASUREONCE
     
@@ -131,13 +180,29 @@ IGL_INLINE void measure_once_cut_twice(const Eigen::PlainObjectBase<derivedV>& V
     }
     
     //Define the close vertices as boundary, so they will not be cut again
+    //Only copies of the same vertex are compared, so group the retV rows by their vertex first
+    std::vector<t_E_i> copyOffsets(V.rows()+1, 0);
+    for(int v=0; v<retV.rows(); ++v)
+        ++copyOffsets[retVtoVmap(v)+1];
+    for(int vert=0; vert<V.rows(); ++vert)
+        copyOffsets[vert+1] += copyOffsets[vert];
+    std::vector<t_E_i> copies(retV.rows());
+    std::vector<t_E_i> copyFill(copyOffsets.begin(), copyOffsets.end()-1);
+    for(int v=0; v<retV.rows(); ++v)
+        copies[copyFill[retVtoVmap(v)]++] = v;
+    
     std::vector<bool> forbiddenToCut(V.rows(), false);
-    for(int v1=0; v1<retV.rows(); ++v1)
-        for(int v2=v1+1; v2<retV.rows(); ++v2)
-            if(retVtoVmap(v1)==retVtoVmap(v2) && (retV.row(v1)-retV.row(v2)).norm() < CLOSE_VERTEX_THRESHOLD*igl::bounding_box_diagonal(retV))
-                for(const int& f : VF[retVtoVmap(v1)])
-                    for(int j=0; j<3; ++j)
-                        forbiddenToCut[F(f,j)] = true;
+    const t_retV_s closeDistance = CLOSE_VERTEX_THRESHOLD*igl::bounding_box_diagonal(retV);
+    for(int vert=0; vert<V.rows(); ++vert) {
+        bool close = false;
+        for(t_E_i i1=copyOffsets[vert]; i1<copyOffsets[vert+1] && !close; ++i1)
+            for(t_E_i i2=i1+1; i2<copyOffsets[vert+1] && !close; ++i2)
+                close = (retV.row(copies[i1])-retV.row(copies[i2])).norm() < closeDistance;
+        if(close)
+            for(const int& f : VF[vert])
+                for(int j=0; j<3; ++j)
+                    forbiddenToCut[F(f,j)] = true;
+    }
     
     /*std::vector<t_E_i> oldCutList;
     igl::boundary_loop(retF, oldCutList);
@@ -173,8 +238,23 @@ IGL_INLINE void measure_once_cut_twice(const Eigen::PlainObjectBase<derivedV>& V
     }
     
     
+#if CUT_METHOD == CUT_INCREMENTAL
+    incrementalCut.update(V, F, edgesC, isB, minCurvatureVecs, punctureList, cut);
+#elif CUT_METHOD == CUT_VORONOI
+    compute_cut_voronoi(V, F, E, edgesC, TT, TTi, VF, VFi, isB, punctureList, cut);
+#else
     compute_cut_erickson(V, F, E, edgesC, TT, TTi, VF, VFi, isB, punctureList, cut);
-    flatten_cut(V, F, E, edgesC, TT, TTi, VF, VFi, isB, cut, retV, retF, error);
 #endif
+    flatten_cut(V, F, E, edgesC, TT, TTi, VF, VFi, isB, cut, scpSolver, retV, retF, error);
+#endif
+    
+    //Pack the charts on a sheet at their size in 3D, ready for write_cut_meshes
+    if(PACK_SHEET_WIDTH >= 0) {
+        t_Vv doubleAreas;
+        igl::doublearea(V, F, doubleAreas);
+        const t_retV_s area = 0.5*doubleAreas.sum();
+        const t_retV_s length = std::sqrt(area);
+        pack_charts(retV, retF, t_retV_s(PACK_SHEET_WIDTH*length), t_retV_s(PACK_SPACING*length), area);
+    }
     
 }
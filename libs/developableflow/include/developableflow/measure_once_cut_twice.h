@@ -26,22 +26,44 @@
 
 #include <igl/igl_inline.h>
 
+#include <developableflow/incremental_cut.h>
+#include <developableflow/scp_solver.h>
+
 #include <Eigen/Core>
 #include <vector>
 
 //Returns 0 on success, error code otherwise
 
-template <typename derivedV, typename derivedE, typename indexType, typename thresholdType, typename derivedCut, typename derivedRetV, typename derivedRetE, typename derivedRetErr>
+template <typename derivedV, typename derivedF, typename derivedTTi, typename derivedE, typename derivedEMAP, typename indexType, typename cornerType, typename thresholdType, typename derivedCut, typename derivedRetV, typename derivedRetE, typename derivedRetErr>
+IGL_INLINE void measure_once_cut_twice(const Eigen::PlainObjectBase<derivedV>& V, //Vertices
+                                       const Eigen::PlainObjectBase<derivedF>& F, //Faces
+                                       const Eigen::PlainObjectBase<derivedE>& E, //Edges
+                                       const Eigen::PlainObjectBase<derivedEMAP>& edgesC, //EMAP
+                                       const Eigen::PlainObjectBase<derivedF>& TT, //TT from triangle_triangle_adjacency
+                                       const Eigen::PlainObjectBase<derivedTTi>& TTi, //TTi from triangle_triangle_adjacency
+                                       const std::vector<std::vector<indexType> >& VF, //VF from vertex_triangle_adjacency
+                                       const std::vector<std::vector<cornerType> >& VFi, //VFi from vertex_triangle_adjacency
+                                       const std::vector<bool>& isB, //isB from is_border_vertex
+                                       const thresholdType& cutThreshold, //The threshold value used to start the cut with
+                                       Eigen::PlainObjectBase<derivedCut>& cut, //A list of edges that make up the cut, indexed into E
+                                       Eigen::PlainObjectBase<derivedRetV>& retV, //return mesh vertices
+                                       Eigen::PlainObjectBase<derivedRetE>& retF, //return mesh faces
+                                       Eigen::PlainObjectBase<derivedRetErr>& error); //flattening error
+
+//Same, with the state that is kept between calls on the same mesh owned by the caller
+template <typename derivedV, typename derivedF, typename derivedTTi, typename derivedE, typename derivedEMAP, typename indexType, typename cornerType, typename thresholdType, typename derivedCut, typename derivedRetV, typename derivedRetE, typename derivedRetErr>
 IGL_INLINE void measure_once_cut_twice(const Eigen::PlainObjectBase<derivedV>& V, //Vertices
-                                       const Eigen::PlainObjectBase<derivedE>& F, //Faces
+                                       const Eigen::PlainObjectBase<derivedF>& F, //Faces
                                        const Eigen::PlainObjectBase<derivedE>& E, //Edges
-                                       const Eigen::PlainObjectBase<derivedE>& edgesC, //EMAP
-                                       const Eigen::PlainObjectBase<derivedE>& TT, //TT from triangle_triangle_adjacency
-                                       const Eigen::PlainObjectBase<derivedE>& TTi, //TTi from triangle_triangle_adjacency
+                                       const Eigen::PlainObjectBase<derivedEMAP>& edgesC, //EMAP
+                                       const Eigen::PlainObjectBase<derivedF>& TT, //TT from triangle_triangle_adjacency
+                                       const Eigen::PlainObjectBase<derivedTTi>& TTi, //TTi from triangle_triangle_adjacency
                                        const std::vector<std::vector<indexType> >& VF, //VF from vertex_triangle_adjacency
-                                       const std::vector<std::vector<indexType> >& VFi, //VFi from vertex_triangle_adjacency
+                                       const std::vector<std::vector<cornerType> >& VFi, //VFi from vertex_triangle_adjacency
                                        const std::vector<bool>& isB, //isB from is_border_vertex
                                        const thresholdType& cutThreshold, //The threshold value used to start the cut with
+                                       IncrementalCut<typename derivedV::Scalar, typename derivedE::Scalar>& incrementalCut, //Keeps the cut paths between calls with CUT_INCREMENTAL, one per mesh
+                                       ScpSolver<typename derivedV::Scalar>& scpSolver, //Keeps the SCP factorization and eigenvector between calls, one per mesh
                                        Eigen::PlainObjectBase<derivedCut>& cut, //A list of edges that make up the cut, indexed into E
                                        Eigen::PlainObjectBase<derivedRetV>& retV, //return mesh vertices
                                        Eigen::PlainObjectBase<derivedRetE>& retF, //return mesh faces
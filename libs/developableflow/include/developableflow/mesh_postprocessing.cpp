@@ -32,6 +32,10 @@
 #include <igl/per_face_normals.h>
 #include <igl/is_vertex_manifold.h>
 #include <igl/is_edge_manifold.h>
+#include <tools/thread_pool.h>
+
+#include <vector>
+#include <numeric>
 
 #include <tools/triangle_cosdihedral_angle.h>
 
@@ -43,24 +47,24 @@
 #define FACE_COLLAPSE_THRESHOLD 2e-9 //1e-8
 
 
-template <typename derivedV, typename derivedF>
+template <typename derivedV, typename derivedF, typename derivedTTi, typename derivedE, typename derivedEMAP, typename indexType>
 IGL_INLINE int mesh_postprocessing(
                                    Eigen::PlainObjectBase<derivedV>& V,
                                    Eigen::PlainObjectBase<derivedF>& F,
-                                   const Eigen::PlainObjectBase<derivedF>& E,
-                                   const Eigen::PlainObjectBase<derivedF>& edgesC,
+                                   const Eigen::PlainObjectBase<derivedE>& E,
+                                   const Eigen::PlainObjectBase<derivedEMAP>& edgesC,
                                    const Eigen::PlainObjectBase<derivedF>& TT,
-                                   const Eigen::PlainObjectBase<derivedF>& TTi,
-                                   const std::vector<std::vector<typename OMatrixXi::Scalar> >& VF,
+                                   const Eigen::PlainObjectBase<derivedTTi>& TTi,
+                                   const std::vector<std::vector<indexType> >& VF,
                                    const bool& removeUnreferenced)
 {
     typedef typename derivedV::Scalar t_V_s;
     typedef Eigen::Matrix<t_V_s, 3, 1> t_V3;
     typedef Eigen::Matrix<t_V_s, 1, 3> t_V3t;
-    typedef Eigen::Matrix<t_V_s, Eigen::Dynamic, 3> t_V;
+    typedef Eigen::Matrix<t_V_s, Eigen::Dynamic, 3, (derivedV::IsRowMajor ? Eigen::RowMajor : Eigen::ColMajor)> t_V;
     typedef Eigen::Matrix<t_V_s, Eigen::Dynamic, 1> t_Vv;
     typedef typename derivedF::Scalar t_F_i;
-    typedef Eigen::Matrix<t_F_i, Eigen::Dynamic, 3> t_F;
+    typedef Eigen::Matrix<t_F_i, Eigen::Dynamic, 3, (derivedF::IsRowMajor ? Eigen::RowMajor : Eigen::ColMajor)> t_F;
     typedef Eigen::Matrix<t_F_i, 1, 3> t_F3t;
     typedef Eigen::Matrix<t_F_i, Eigen::Dynamic, Eigen::Dynamic> t_Fdyn;
     typedef Eigen::Matrix<t_F_i, Eigen::Dynamic, 1> t_FV;
@@ -77,7 +81,7 @@ IGL_INLINE int mesh_postprocessing(
     //Flip edges
     int edgesFlipped = 0;
     
-    t_F TTm = TT, TTim = TTi;
+    t_F TTm = TT, TTim = TTi.template cast<t_F_i>();
     const auto flip_edge = [&F, &E, &TTm, &TTim, &edgesFlipped] (const t_F_i& face, const t_F_i& j) {
         const t_F_i& adjFace = TTm(face, (j+1)%3);
         const t_F_i& adjJ = (TTim(face, (j+1)%3)+2)%3;
@@ -194,9 +198,18 @@ IGL_INLINE int mesh_postprocessing(
             t_FV EMAP = edgesC;
             t_Fdyn nE = E;
             
+            const auto is_null_face = [&oldF] (const int& f) {
+                return oldF(f,0) == IGL_COLLAPSE_EDGE_NULL && oldF(f,1) == IGL_COLLAPSE_EDGE_NULL && oldF(f,2) == IGL_COLLAPSE_EDGE_NULL;
+            };
+            
+#ifndef PARALLEL_COMPUTATION
+            //SERIAL VERSION
             for(typename std::set<t_F_i>::iterator iter = edgesToRemove.begin(); iter != edgesToRemove.end(); ++iter) {
                 const t_F_i& edge = *iter;
-                const Eigen::RowVector3d& p = dV.row(E(edge,0));
+                if(nE(edge,0) == IGL_COLLAPSE_EDGE_NULL && nE(edge,1) == IGL_COLLAPSE_EDGE_NULL)
+                    continue; //Already removed by an earlier collapse
+                //Current endpoint, earlier collapses may have moved the edge onto another vertex
+                const Eigen::RowVector3d p = dV.row(nE(edge,0));
                 
                 igl::collapse_edge(edge, p, dV, oldF, nE, EMAP, EF, EI);
             }
@@ -206,12 +219,95 @@ IGL_INLINE int mesh_postprocessing(
             int m = 0;
             for(int f = 0; f<oldF.rows(); ++f)
             {
-                if(oldF(f,0) != IGL_COLLAPSE_EDGE_NULL || oldF(f,1) != IGL_COLLAPSE_EDGE_NULL || oldF(f,2) != IGL_COLLAPSE_EDGE_NULL) {
+                if(!is_null_face(f)) {
                     F.row(m) = oldF.row(f);
                     ++m;
                 }
             }
             F.conservativeResize(m, 3);
+#else
+            //PARALLEL VERSION
+            //Collapse in rounds. Every round picks a maximal independent set of the pending edges such that no two
+            //chosen edges share a vertex of their 1-rings. igl::collapse_edge only writes to the faces around the
+            //collapsed edge and to the edges of those faces, so the collapses of one round touch disjoint rows.
+            std::vector<t_F_i> pendingEdges(edgesToRemove.begin(), edgesToRemove.end());
+            std::vector<int> claimedInRound(V.rows(), -1);
+            std::vector<t_F_i> ringOffsets, ringFaces;
+            for(int round=0; !pendingEdges.empty(); ++round) {
+                //Vertex-face adjacency of the current (partially collapsed) mesh, in CSR form
+                ringOffsets.assign(V.rows()+1, 0);
+                for(int f=0; f<oldF.rows(); ++f)
+                    if(!is_null_face(f))
+                        for(int j=0; j<3; ++j)
+                            ++ringOffsets[oldF(f,j)+1];
+                std::partial_sum(ringOffsets.begin(), ringOffsets.end(), ringOffsets.begin());
+                ringFaces.resize(ringOffsets.back());
+                std::vector<t_F_i> ringFill(ringOffsets.begin(), ringOffsets.end()-1);
+                for(int f=0; f<oldF.rows(); ++f)
+                    if(!is_null_face(f))
+                        for(int j=0; j<3; ++j)
+                            ringFaces[ringFill[oldF(f,j)]++] = f;
+                
+                //Greedily pick the independent set, everything else waits for the next round
+                std::vector<t_F_i> roundEdges, deferredEdges;
+                for(const t_F_i& edge : pendingEdges) {
+                    if(nE(edge,0) == IGL_COLLAPSE_EDGE_NULL && nE(edge,1) == IGL_COLLAPSE_EDGE_NULL)
+                        continue; //Already removed by an earlier collapse
+                    
+                    bool independent = true;
+                    for(int k=0; k<2 && independent; ++k) {
+                        const t_F_i& v = nE(edge,k);
+                        for(t_F_i r=ringOffsets[v]; r<ringOffsets[v+1] && independent; ++r)
+                            for(int j=0; j<3; ++j)
+                                if(claimedInRound[oldF(ringFaces[r],j)] == round) {
+                                    independent = false;
+                                    break;
+                                }
+                    }
+                    if(!independent) {
+                        deferredEdges.push_back(edge);
+                        continue;
+                    }
+                    
+                    for(int k=0; k<2; ++k) {
+                        const t_F_i& v = nE(edge,k);
+                        for(t_F_i r=ringOffsets[v]; r<ringOffsets[v+1]; ++r)
+                            for(int j=0; j<3; ++j)
+                                claimedInRound[oldF(ringFaces[r],j)] = round;
+                    }
+                    roundEdges.push_back(edge);
+                }
+                
+                solver_parallel_for(roundEdges.size(), [&] (const int& i) {
+                    const t_F_i& edge = roundEdges[i];
+                    const Eigen::RowVector3d p = dV.row(nE(edge,0));
+                    
+                    igl::collapse_edge(edge, p, dV, oldF, nE, EMAP, EF, EI);
+                });
+                
+                pendingEdges.swap(deferredEdges);
+            }
+            
+            //remove all IGL_COLLAPSE_EDGE_NULL faces. Parallel prefix sum over blocks of faces
+            const int nBlocks = std::max(1, std::min((int) solver_thread_pool().size(), (int) oldF.rows()));
+            const int blockSize = (oldF.rows() + nBlocks - 1) / nBlocks;
+            std::vector<int> blockStart(nBlocks+1, 0);
+            solver_parallel_for(nBlocks, [&] (const int& b) {
+                const int end = std::min<int>((b+1)*blockSize, oldF.rows());
+                for(int f=b*blockSize; f<end; ++f)
+                    if(!is_null_face(f))
+                        ++blockStart[b+1];
+            }, 1);
+            std::partial_sum(blockStart.begin(), blockStart.end(), blockStart.begin());
+            F = t_F(blockStart[nBlocks], 3);
+            solver_parallel_for(nBlocks, [&] (const int& b) {
+                const int end = std::min<int>((b+1)*blockSize, oldF.rows());
+                int m = blockStart[b];
+                for(int f=b*blockSize; f<end; ++f)
+                    if(!is_null_face(f))
+                        F.row(m++) = oldF.row(f);
+            }, 1);
+#endif
             
             //Move collapsed edge points to average
             for(typename std::set<t_F_i>::iterator iter = edgesToRemove.begin(); iter != edgesToRemove.end(); ++iter) {
@@ -30,17 +30,18 @@
 
 //Perform the mesh postprocessing, such as removing small triangles etc.
 //Returns 0 if no changes happened, returns 1 if a change to F happened
+//With PARALLEL_COMPUTATION, short edges are collapsed concurrently in rounds of independent sets (no shared 1-ring vertices)
 
 
-template <typename derivedV, typename derivedF, typename derivedEnergy>
+template <typename derivedV, typename derivedF, typename derivedTTi, typename derivedE, typename derivedEMAP, typename indexType>
 IGL_INLINE int mesh_postprocessing(
                                    Eigen::PlainObjectBase<derivedV>& V, //Vertices
                                    Eigen::PlainObjectBase<derivedF>& F, //Faces
-                                   const Eigen::PlainObjectBase<derivedF>& E, //Edges list
-                                   const Eigen::PlainObjectBase<derivedF>& edgesC, //EMAP
+                                   const Eigen::PlainObjectBase<derivedE>& E, //Edges list
+                                   const Eigen::PlainObjectBase<derivedEMAP>& edgesC, //EMAP
                                    const Eigen::PlainObjectBase<derivedF>& TT, //TT from triangle_triangle_adjacency
-                                   const Eigen::PlainObjectBase<derivedF>& TTi, //TTi from triangle_triangle_adjacency
-                                   const std::vector<std::vector<typename OMatrixXi::Scalar> >& VF, //Vertex-face adjacency
+                                   const Eigen::PlainObjectBase<derivedTTi>& TTi, //TTi from triangle_triangle_adjacency
+                                   const std::vector<std::vector<indexType> >& VF, //Vertex-face adjacency
                                    const bool& removeUnreferenced=true); //Should we remove unreferenced?
 
 
@@ -0,0 +1,323 @@
+/*
+
+ 2018, Oded Stein, Eitan Grinspun and Keenan Crane
+
+ This file is part of the code for "Developability of Triangle Meshes".
+
+ The code for "Developability of Triangle Meshes" is free software: you can
+ redistribute it and/or modify it under the terms of the GNU General Public
+ License as published by the Free Software Foundation, either version 2 of the
+ License, or (at your option) any later version.
+
+ The code for "Developability of Triangle Meshes" is distributed in the hope
+ that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with the code for "Developability of Triangle Meshes". If not,
+ see <https://www.gnu.org/licenses/>.
+
+ */
+
+
+#include "native_parameterization.h"
+
+#include <developableflow/flatten_charts.h>
+
+#include <Eigen/Geometry>
+#include <Eigen/Sparse>
+#include <Eigen/SparseCholesky>
+
+#include <algorithm>
+#include <utility>
+#include <cmath>
+
+
+template <typename derivedV, typename derivedF, typename derivedUV>
+IGL_INLINE int flatten_chart(const Eigen::PlainObjectBase<derivedV>& V,
+                             const Eigen::PlainObjectBase<derivedF>& F,
+                             Eigen::PlainObjectBase<derivedUV>& uv,
+                             const int& arapIterations)
+{
+    typedef typename derivedV::Scalar t_s;
+    typedef Eigen::Matrix<t_s, 3, 1> t_V3;
+    typedef Eigen::Matrix<t_s, 2, 1> t_V2;
+    typedef Eigen::Matrix<t_s, 2, 2> t_M2;
+    typedef Eigen::Matrix<t_s, 2, 3> t_tri;
+    typedef Eigen::Matrix<t_s, Eigen::Dynamic, 2> t_UV;
+    typedef Eigen::Matrix<t_s, Eigen::Dynamic, 1> t_Vv;
+    typedef Eigen::SparseMatrix<t_s> t_sparse;
+    typedef Eigen::Triplet<t_s> t_triplet;
+    
+    const int nV = V.rows();
+    const int nF = F.rows();
+    uv.resize(nV, 2);
+    uv.setZero();
+    if(nV < 3 || nF < 1)
+        return 0;
+    
+    //Triangles in local 2D frames, and half the cotangent at each corner
+    std::vector<t_tri> triangles(nF);
+    std::vector<t_V3> halfCot(nF);
+    t_s totalArea = 0;
+    for(int face=0; face<nF; ++face) {
+        const t_V3 e1 = (V.row(F(face,1)) - V.row(F(face,0))).transpose();
+        const t_V3 e2 = (V.row(F(face,2)) - V.row(F(face,0))).transpose();
+        const t_s l1 = e1.norm();
+        const t_s doubleArea = e1.cross(e2).norm();
+        totalArea += 0.5*doubleArea;
+        t_tri& tri = triangles[face];
+        tri.col(0).setZero();
+        tri.col(1) << l1, 0;
+        tri.col(2) << (l1>0 ? e1.dot(e2)/l1 : 0), (l1>0 ? doubleArea/l1 : 0);
+        for(int j=0; j<3; ++j) {
+            const t_V2 a = tri.col((j+1)%3) - tri.col(j);
+            const t_V2 b = tri.col((j+2)%3) - tri.col(j);
+            const t_s cross = a(0)*b(1) - a(1)*b(0);
+            halfCot[face](j) = cross>0 ? 0.5*a.dot(b)/cross : 0;
+        }
+    }
+    if(!(totalArea > 0))
+        return 0;
+    
+    //Cotan Laplacian, the weight of the edge opposite corner j is half its cotangent
+    std::vector<t_triplet> tripletsL;
+    tripletsL.reserve(12*nF);
+    for(int face=0; face<nF; ++face) {
+        for(int j=0; j<3; ++j) {
+            const int a = F(face,(j+1)%3), b = F(face,(j+2)%3);
+            const t_s& w = halfCot[face](j);
+            tripletsL.emplace_back(a, a, w);
+            tripletsL.emplace_back(b, b, w);
+            tripletsL.emplace_back(a, b, -w);
+            tripletsL.emplace_back(b, a, -w);
+        }
+    }
+    
+    //Boundary halfedges are the ones whose opposite does not exist
+    std::vector<std::pair<int, int> > halfedges;
+    halfedges.reserve(3*nF);
+    for(int face=0; face<nF; ++face)
+        for(int j=0; j<3; ++j)
+            halfedges.emplace_back(F(face,j), F(face,(j+1)%3));
+    std::vector<std::pair<int, int> > sortedHalfedges = halfedges;
+    std::sort(sortedHalfedges.begin(), sortedHalfedges.end());
+    std::vector<std::pair<int, int> > boundary;
+    for(const auto& he : halfedges)
+        if(!std::binary_search(sortedHalfedges.begin(), sortedHalfedges.end(), std::make_pair(he.second, he.first)))
+            boundary.push_back(he);
+    
+    //Pin the two boundary vertices farthest apart (approximately)
+    const auto farthest_from = [&] (const int& from) {
+        int best = from;
+        t_s bestDist = -1;
+        const auto consider = [&] (const int& v) {
+            const t_s dist = (V.row(v) - V.row(from)).squaredNorm();
+            if(dist > bestDist) {
+                bestDist = dist;
+                best = v;
+            }
+        };
+        if(boundary.empty())
+            for(int v=0; v<nV; ++v)
+                consider(v);
+        else
+            for(const auto& he : boundary)
+                consider(he.first);
+        return best;
+    };
+    const int pin0 = farthest_from(farthest_from(boundary.empty() ? F(0,0) : boundary[0].first));
+    const int pin1 = farthest_from(pin0);
+    if(pin0 == pin1)
+        return 1;
+    
+    //LSCM: conformal energy E_D - A in (x, y), with the area as a sum over the boundary
+    std::vector<t_triplet> tripletsQ;
+    tripletsQ.reserve(2*tripletsL.size() + 4*boundary.size());
+    for(const t_triplet& t : tripletsL) {
+        tripletsQ.emplace_back(t.row(), t.col(), t.value());
+        tripletsQ.emplace_back(nV+t.row(), nV+t.col(), t.value());
+    }
+    for(const auto& he : boundary) {
+        tripletsQ.emplace_back(he.first, nV+he.second, -0.5);
+        tripletsQ.emplace_back(he.second, nV+he.first, 0.5);
+        tripletsQ.emplace_back(nV+he.second, he.first, -0.5);
+        tripletsQ.emplace_back(nV+he.first, he.second, 0.5);
+    }
+    
+    //Reduce to the free variables and solve
+    t_Vv fixedValues = t_Vv::Zero(2*nV);
+    std::vector<int> freeIndex(2*nV);
+    fixedValues(pin1) = (V.row(pin1) - V.row(pin0)).norm();
+    int nFree = 0;
+    for(int i=0; i<2*nV; ++i)
+        freeIndex[i] = (i==pin0 || i==pin1 || i==nV+pin0 || i==nV+pin1) ? -1 : nFree++;
+    std::vector<t_triplet> tripletsQff;
+    tripletsQff.reserve(tripletsQ.size());
+    t_Vv rhs = t_Vv::Zero(nFree);
+    for(const t_triplet& t : tripletsQ) {
+        const int r = freeIndex[t.row()], c = freeIndex[t.col()];
+        if(r < 0)
+            continue;
+        if(c < 0)
+            rhs(r) -= t.value()*fixedValues(t.col());
+        else
+            tripletsQff.emplace_back(r, c, t.value());
+    }
+    t_sparse Qff(nFree, nFree);
+    Qff.setFromTriplets(tripletsQff.begin(), tripletsQff.end());
+    Eigen::SimplicialLDLT<t_sparse> lscmSolver(Qff);
+    if(lscmSolver.info() != Eigen::Success)
+        return 1;
+    const t_Vv lscm = lscmSolver.solve(rhs);
+    for(int i=0; i<2*nV; ++i)
+        uv(i%nV, i/nV) = freeIndex[i]<0 ? fixedValues(i) : lscm(freeIndex[i]);
+    
+    //Mirror if the map came out with the wrong orientation
+    t_s signedArea = 0;
+    for(int face=0; face<nF; ++face) {
+        const t_V2 a = (uv.row(F(face,1)) - uv.row(F(face,0))).transpose();
+        const t_V2 b = (uv.row(F(face,2)) - uv.row(F(face,0))).transpose();
+        signedArea += a(0)*b(1) - a(1)*b(0);
+    }
+    if(signedArea < 0)
+        uv.col(1) *= -1;
+    
+    //ARAP, local-global with pin0 fixed
+    std::vector<int> freeVertex(nV);
+    nFree = 0;
+    for(int v=0; v<nV; ++v)
+        freeVertex[v] = v==pin0 ? -1 : nFree++;
+    std::vector<t_triplet> tripletsLff;
+    tripletsLff.reserve(tripletsL.size());
+    for(const t_triplet& t : tripletsL)
+        if(freeVertex[t.row()] >= 0 && freeVertex[t.col()] >= 0)
+            tripletsLff.emplace_back(freeVertex[t.row()], freeVertex[t.col()], t.value());
+    t_sparse Lff(nFree, nFree);
+    Lff.setFromTriplets(tripletsLff.begin(), tripletsLff.end());
+    Eigen::SimplicialLDLT<t_sparse> arapSolver(Lff);
+    if(arapSolver.info() != Eigen::Success)
+        return 0; //keep the LSCM result
+    
+    std::vector<t_M2> rotations(nF);
+    t_UV arapRhs(nV, 2), arapRhsf(nFree, 2);
+    for(int iter=0; iter<arapIterations; ++iter) {
+        //Local step: closest rotation to the Jacobian of every face
+        for(int face=0; face<nF; ++face) {
+            t_M2 S = t_M2::Zero();
+            for(int j=0; j<3; ++j) {
+                const int a = (j+1)%3, b = (j+2)%3;
+                S += halfCot[face](j) * (uv.row(F(face,a)) - uv.row(F(face,b))).transpose() * (triangles[face].col(a) - triangles[face].col(b)).transpose();
+            }
+            const t_s angle = std::atan2(S(1,0) - S(0,1), S(0,0) + S(1,1));
+            rotations[face] << std::cos(angle), -std::sin(angle), std::sin(angle), std::cos(angle);
+        }
+        
+        //Global step
+        arapRhs.setZero();
+        for(int face=0; face<nF; ++face) {
+            for(int j=0; j<3; ++j) {
+                const int a = (j+1)%3, b = (j+2)%3;
+                const t_V2 d = halfCot[face](j) * rotations[face] * (triangles[face].col(a) - triangles[face].col(b));
+                arapRhs.row(F(face,a)) += d.transpose();
+                arapRhs.row(F(face,b)) -= d.transpose();
+            }
+        }
+        for(const t_triplet& t : tripletsL)
+            if(t.col() == pin0)
+                arapRhs.row(t.row()) -= t.value()*uv.row(pin0);
+        for(int v=0; v<nV; ++v)
+            if(freeVertex[v] >= 0)
+                arapRhsf.row(freeVertex[v]) = arapRhs.row(v);
+        const t_UV solution = arapSolver.solve(arapRhsf);
+        for(int v=0; v<nV; ++v)
+            if(freeVertex[v] >= 0)
+                uv.row(v) = solution.row(freeVertex[v]);
+    }
+    
+    return 0;
+}
+
+
+template <typename derivedV, typename derivedF, typename derivedRetV, typename derivedRetF>
+IGL_INLINE int native_parameterization(const Eigen::PlainObjectBase<derivedV>& V,
+                                       const Eigen::PlainObjectBase<derivedF>& F,
+                                       Eigen::PlainObjectBase<derivedRetV>& retV,
+                                       Eigen::PlainObjectBase<derivedRetF>& retF)
+{
+    typedef typename derivedV::Scalar t_s;
+    typedef Eigen::Matrix<t_s, 3, 1> t_V3;
+    typedef Eigen::Matrix<t_s, Eigen::Dynamic, 3> t_V;
+    typedef Eigen::Matrix<t_s, Eigen::Dynamic, 2> t_UV;
+    typedef Eigen::Matrix<int, Eigen::Dynamic, 3> t_F;
+    
+    const int nF = F.rows();
+    int retVal = 0;
+    
+    //Face normals and areas
+    std::vector<t_V3> normals(nF);
+    std::vector<t_s> areas(nF);
+    for(int face=0; face<nF; ++face) {
+        const t_V3 e1 = (V.row(F(face,1)) - V.row(F(face,0))).transpose();
+        const t_V3 e2 = (V.row(F(face,2)) - V.row(F(face,0))).transpose();
+        const t_V3 n = e1.cross(e2);
+        areas[face] = 0.5*n.norm();
+        normals[face] = areas[face]>0 ? t_V3(n.normalized()) : t_V3::Zero();
+    }
+    
+    //Faces sharing an edge, from the sorted list of undirected edges
+    std::vector<std::pair<std::pair<int, int>, int> > faceEdges;
+    faceEdges.reserve(3*nF);
+    for(int face=0; face<nF; ++face)
+        for(int j=0; j<3; ++j) {
+            const int a = F(face,(j+1)%3), b = F(face,(j+2)%3);
+            faceEdges.emplace_back(std::make_pair(std::min(a,b), std::max(a,b)), face);
+        }
+    std::sort(faceEdges.begin(), faceEdges.end());
+    std::vector<std::vector<int> > neighbors(nF);
+    for(size_t i=0; i+1<faceEdges.size(); ++i)
+        if(faceEdges[i].first == faceEdges[i+1].first) {
+            neighbors[faceEdges[i].second].push_back(faceEdges[i+1].second);
+            neighbors[faceEdges[i+1].second].push_back(faceEdges[i].second);
+        }
+    
+    //Split into charts by growing regions while the normals stay close to the chart's average normal
+    const t_s cosLimit = std::cos(NATIVE_ANGLE_LIMIT*M_PI/180.);
+    std::vector<int> chartOfFace(nF, -1);
+    std::vector<int> chartFaces;
+    int nCharts = 0;
+    for(int seed=0; seed<nF; ++seed) {
+        if(chartOfFace[seed] >= 0)
+            continue;
+        chartOfFace[seed] = nCharts;
+        chartFaces.assign(1, seed);
+        t_V3 chartNormal = areas[seed]*normals[seed];
+        for(size_t i=0; i<chartFaces.size(); ++i) {
+            for(const int& neighbor : neighbors[chartFaces[i]]) {
+                if(chartOfFace[neighbor] >= 0)
+                    continue;
+                const t_s norm = chartNormal.norm();
+                if(norm > 0 && areas[neighbor] > 0 && normals[neighbor].dot(chartNormal)/norm < cosLimit)
+                    continue;
+                chartOfFace[neighbor] = nCharts;
+                chartFaces.push_back(neighbor);
+                chartNormal += areas[neighbor]*normals[neighbor];
+            }
+        }
+        ++nCharts;
+    }
+    
+    //Flatten the charts concurrently and lay them out
+    const auto flatten_one = [] (const t_V& chartV, const t_F& chartF, t_UV& chartUV) {
+        return flatten_chart(chartV, chartF, chartUV);
+    };
+    retVal = flatten_charts(V, F, chartOfFace, nCharts, flatten_one, retV, retF);
+    
+    //Scale into the unit square
+    const t_s extent = retV.leftCols(2).maxCoeff();
+    if(extent > 0)
+        retV /= extent;
+    
+    return retVal;
+}
@@ -0,0 +1,65 @@
+/*
+
+ 2018, Oded Stein, Eitan Grinspun and Keenan Crane
+
+ This file is part of the code for "Developability of Triangle Meshes".
+
+ The code for "Developability of Triangle Meshes" is free software: you can
+ redistribute it and/or modify it under the terms of the GNU General Public
+ License as published by the Free Software Foundation, either version 2 of the
+ License, or (at your option) any later version.
+
+ The code for "Developability of Triangle Meshes" is distributed in the hope
+ that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with the code for "Developability of Triangle Meshes". If not,
+ see <https://www.gnu.org/licenses/>.
+
+ */
+
+
+#ifndef DEVELOPABLEFLOW_NATIVE_PARAMETERIZATION_H
+#define DEVELOPABLEFLOW_NATIVE_PARAMETERIZATION_H
+
+#include <igl/igl_inline.h>
+
+#include <Eigen/Core>
+#include <vector>
+
+
+#define NATIVE_ANGLE_LIMIT 66. //Maximum angle in degrees between a face normal and the average normal of its chart
+#define NATIVE_ARAP_ITERATIONS 10 //Local-global iterations after the conformal initialization
+
+
+//Flatten a single connected chart with boundary: LSCM with the two boundary vertices farthest apart pinned, then ARAP.
+//With zero ARAP iterations this is plain LSCM.
+//The result has the scale of the 3D chart.
+//Returns 0 on success, error code otherwise
+template <typename derivedV, typename derivedF, typename derivedUV>
+IGL_INLINE int flatten_chart(const Eigen::PlainObjectBase<derivedV>& V, //Vertices of the chart
+                             const Eigen::PlainObjectBase<derivedF>& F, //Faces of the chart
+                             Eigen::PlainObjectBase<derivedUV>& uv, //return value uv coordinates, one row per vertex
+                             const int& arapIterations = NATIVE_ARAP_ITERATIONS); //Local-global ARAP iterations after LSCM
+
+
+//In-process replacement for Blender's smart UV project.
+//The mesh is split into charts of faces whose normals stay within NATIVE_ANGLE_LIMIT of the chart's average normal,
+//every chart is flattened with LSCM followed by ARAP (concurrently, see flatten_charts), and the charts are laid out in rows in the unit square.
+//Vertices on chart boundaries are duplicated, retF has the faces of F in the same order.
+//Returns 0 on success, error code otherwise
+template <typename derivedV, typename derivedF, typename derivedRetV, typename derivedRetF>
+IGL_INLINE int native_parameterization(const Eigen::PlainObjectBase<derivedV>& V, //Vertices
+                                       const Eigen::PlainObjectBase<derivedF>& F, //Faces
+                                       Eigen::PlainObjectBase<derivedRetV>& retV, //return value uv coordinates, third column zero
+                                       Eigen::PlainObjectBase<derivedRetF>& retF); //return value faces into retV
+
+
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "native_parameterization.cpp"
+#endif
+
+#endif
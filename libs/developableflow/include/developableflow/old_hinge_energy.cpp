@@ -38,12 +38,12 @@
 
 
 
-template <typename derivedV, typename derivedF, typename indexType, typename derivedEnergy, typename derivedEnergyGrad>
+template <typename derivedV, typename derivedF, typename indexType, typename cornerType, typename derivedEnergy, typename derivedEnergyGrad>
 IGL_INLINE void old_hinge_energy_and_grad(
                                           const Eigen::PlainObjectBase<derivedV>& V,
                                           const Eigen::PlainObjectBase<derivedF>& F,
                                           const std::vector<std::vector<indexType> >& VF,
-                                          const std::vector<std::vector<indexType> >& VFi,
+                                          const std::vector<std::vector<cornerType> >& VFi,
                                           const std::vector<bool>& isB,
                                           Eigen::PlainObjectBase<derivedEnergy>& energy,
                                           Eigen::PlainObjectBase<derivedEnergyGrad>& energyGrad)
@@ -94,7 +94,7 @@ IGL_INLINE void old_hinge_energy_and_grad(
             
             const t_V3& Nv = vertexNormals.row(vert);
             const std::vector<indexType>& adjacentFaces = VF[vert];
-            const std::vector<indexType>& adjacentFacesi = VFi[vert];
+            const std::vector<cornerType>& adjacentFacesi = VFi[vert];
             for(int f=0; f<adjacentFaces.size(); ++f) {
                 const int& face = adjacentFaces[f];
                 const int& j = adjacentFacesi[f];
@@ -154,12 +154,12 @@ IGL_INLINE void old_hinge_energy_and_grad(
     }
     
     
-    template <typename derivedV, typename derivedF, typename indexType, typename derivedEnergy, typename derivedMinCurvatureDirs>
+    template <typename derivedV, typename derivedF, typename indexType, typename cornerType, typename derivedEnergy, typename derivedMinCurvatureDirs>
     IGL_INLINE void old_hinge_energy(
                                      const Eigen::PlainObjectBase<derivedV>& V,
                                      const Eigen::PlainObjectBase<derivedF>& F,
                                      const std::vector<std::vector<indexType> >& VF,
-                                     const std::vector<std::vector<indexType> >& VFi,
+                                     const std::vector<std::vector<cornerType> >& VFi,
                                      const std::vector<bool>& isB,
                                      Eigen::PlainObjectBase<derivedEnergy>& energy,
                                      Eigen::PlainObjectBase<derivedMinCurvatureDirs>& minCurvatureDirs)
@@ -197,7 +197,7 @@ IGL_INLINE void old_hinge_energy_and_grad(
                 t_V33 mat = t_V33::Zero();
                 
                 const std::vector<indexType>& adjacentFaces = VF[vert];
-                const std::vector<indexType>& adjacentFacesi = VFi[vert];
+                const std::vector<cornerType>& adjacentFacesi = VFi[vert];
                 for(int f=0; f<adjacentFaces.size(); ++f) {
                     const int& face = adjacentFaces[f];
                     const t_V_s& theta = angles(face, adjacentFacesi[f]);
@@ -215,15 +215,15 @@ IGL_INLINE void old_hinge_energy_and_grad(
             
         }
         
-        template <typename derivedV, typename derivedF, typename indexType, typename derivedEnergy>
+        template <typename derivedV, typename derivedF, typename indexType, typename cornerType, typename derivedEnergy>
         IGL_INLINE void old_hinge_energy(
                                      const Eigen::PlainObjectBase<derivedV>& V,
                                      const Eigen::PlainObjectBase<derivedF>& F,
                                      const std::vector<std::vector<indexType> >& VF,
-                                     const std::vector<std::vector<indexType> >& VFi,
+                                     const std::vector<std::vector<cornerType> >& VFi,
                                      const std::vector<bool>& isB,
                                      Eigen::PlainObjectBase<derivedEnergy>& energy)
         {
-            Eigen::PlainObjectBase<derivedV> dummy;
+            derivedV dummy;
             old_hinge_energy(V, F, VF, VFi, isB, energy, dummy);
         }
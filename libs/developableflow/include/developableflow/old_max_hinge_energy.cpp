@@ -34,12 +34,12 @@
 
 #define INFTY std::numeric_limits<double>::infinity()
 
-template <typename derivedV, typename derivedF, typename indexType, typename derivedEnergy, typename derivedEnergyGrad>
+template <typename derivedV, typename derivedF, typename indexType, typename cornerType, typename derivedEnergy, typename derivedEnergyGrad>
 IGL_INLINE void old_max_hinge_energy_and_grad(
                                           const Eigen::PlainObjectBase<derivedV>& V,
                                           const Eigen::PlainObjectBase<derivedF>& F,
                                           const std::vector<std::vector<indexType> >& VF,
-                                          const std::vector<std::vector<indexType> >& VFi,
+                                          const std::vector<std::vector<cornerType> >& VFi,
                                           const std::vector<bool>& isB,
                                           Eigen::PlainObjectBase<derivedEnergy>& energy,
                                           Eigen::PlainObjectBase<derivedEnergyGrad>& energyGrad)
@@ -101,7 +101,7 @@ IGL_INLINE void old_max_hinge_energy_and_grad(
         }
         
         const std::vector<indexType>& adjacentFaces = VF[vert];
-        const std::vector<indexType>& adjacentFacesi = VFi[vert];
+        const std::vector<cornerType>& adjacentFacesi = VFi[vert];
         
         //Do we have a small number of adjacent triangles?
         if(adjacentFaces.size() == 1) {
@@ -225,7 +225,7 @@ IGL_INLINE void old_max_hinge_energy_and_grad(
             continue;
         
         const std::vector<indexType>& adjacentFaces = VF[vert];
-        const std::vector<indexType>& adjacentFacesi = VFi[vert];
+        const std::vector<cornerType>& adjacentFacesi = VFi[vert];
         
         const t_V3& u = umw.row(vert);
         const t_F_i& maxFace = maxFaces(vert);
@@ -270,12 +270,12 @@ IGL_INLINE void old_max_hinge_energy_and_grad(
 }
 
 
-template <typename derivedV, typename derivedF, typename indexType, typename derivedEnergy>
+template <typename derivedV, typename derivedF, typename indexType, typename cornerType, typename derivedEnergy>
 IGL_INLINE void old_max_hinge_energy(
                                  const Eigen::PlainObjectBase<derivedV>& V,
                                  const Eigen::PlainObjectBase<derivedF>& F,
                                  const std::vector<std::vector<indexType> >& VF,
-                                 const std::vector<std::vector<indexType> >& VFi,
+                                 const std::vector<std::vector<cornerType> >& VFi,
                                  const std::vector<bool>& isB,
                                  Eigen::PlainObjectBase<derivedEnergy>& energy)
 {
@@ -321,7 +321,7 @@ IGL_INLINE void old_max_hinge_energy(
         }
         
         const std::vector<indexType>& adjacentFaces = VF[vert];
-        const std::vector<indexType>& adjacentFacesi = VFi[vert];
+        const std::vector<cornerType>& adjacentFacesi = VFi[vert];
         
         //Do we have a small number of adjacent triangles?
         if(adjacentFaces.size() == 1) {
@@ -0,0 +1,268 @@
+/*
+
+ 2018, Oded Stein, Eitan Grinspun and Keenan Crane
+
+ This file is part of the code for "Developability of Triangle Meshes".
+
+ The code for "Developability of Triangle Meshes" is free software: you can
+ redistribute it and/or modify it under the terms of the GNU General Public
+ License as published by the Free Software Foundation, either version 2 of the
+ License, or (at your option) any later version.
+
+ The code for "Developability of Triangle Meshes" is distributed in the hope
+ that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with the code for "Developability of Triangle Meshes". If not,
+ see <https://www.gnu.org/licenses/>.
+
+ */
+
+
+#include "scp_solver.h"
+
+#include <Eigen/Eigenvalues>
+#include <Eigen/Geometry>
+
+#include <algorithm>
+#include <utility>
+#include <cmath>
+
+
+template <typename t_s>
+IGL_INLINE ScpSolver<t_s>::ScpSolver() :
+nIterations(0), reusedAnalysis(false)
+{
+}
+
+
+template <typename t_s>
+IGL_INLINE void ScpSolver<t_s>::reset()
+{
+    outerPattern.clear();
+    innerPattern.clear();
+    lastY.resize(0);
+}
+
+
+template <typename t_s>
+IGL_INLINE int ScpSolver<t_s>::last_iterations() const
+{
+    return nIterations;
+}
+
+
+template <typename t_s>
+IGL_INLINE bool ScpSolver<t_s>::last_reused_analysis() const
+{
+    return reusedAnalysis;
+}
+
+
+template <typename t_s>
+IGL_INLINE bool ScpSolver<t_s>::same_pattern(const t_sparse_c& A) const
+{
+    if(outerPattern.size() != A.outerSize()+1 || innerPattern.size() != A.nonZeros())
+        return false;
+    return std::equal(outerPattern.begin(), outerPattern.end(), A.outerIndexPtr()) &&
+    std::equal(innerPattern.begin(), innerPattern.end(), A.innerIndexPtr());
+}
+
+
+template <typename t_s>
+IGL_INLINE int ScpSolver<t_s>::solve(const t_sparse_c& A,
+                                     const t_sparse_c& B,
+                                     t_vec_c& y)
+{
+    typedef Eigen::Matrix<t_c, Eigen::Dynamic, Eigen::Dynamic> t_dense_c;
+    
+    const int nDof = A.rows();
+    nIterations = 0;
+    
+    //Factorize, with the symbolic analysis of the last call if the pattern is the same
+    reusedAnalysis = same_pattern(A);
+    if(!reusedAnalysis) {
+        ldlt.analyzePattern(A);
+        outerPattern.assign(A.outerIndexPtr(), A.outerIndexPtr()+A.outerSize()+1);
+        innerPattern.assign(A.innerIndexPtr(), A.innerIndexPtr()+A.nonZeros());
+        lastY.resize(0);
+    }
+    ldlt.factorize(A);
+    if(ldlt.info() != Eigen::Success) {
+        reset();
+        return 1;
+    }
+    
+    //Remove the B-weighted mean (the constant kernel of the conformal energy), and update the products with A and B along
+    const t_vec_c A1 = A*t_vec_c::Ones(nDof), B1 = B*t_vec_c::Ones(nDof);
+    const t_c totalMass = B1.sum();
+    const auto project = [&] (t_vec_c& v, t_vec_c& Av, t_vec_c& Bv) {
+        const t_c mean = B1.dot(v) / totalMass;
+        v.array() -= mean;
+        Av -= mean*A1;
+        Bv -= mean*B1;
+    };
+    
+    //Starting guess, the last eigenvector or one inverse iteration from a random vector
+    t_vec_c x;
+    if(lastY.size() == nDof) {
+        x = lastY;
+    } else {
+        x = t_vec_c::Random(nDof);
+        x = ldlt.solve(B*x);
+    }
+    t_vec_c Ax = A*x, Bx = B*x;
+    project(x, Ax, Bx);
+    {
+        const t_s norm = std::sqrt(std::real(x.dot(Bx)));
+        x /= norm;
+        Ax /= norm;
+        Bx /= norm;
+    }
+    
+    //LOBPCG, the products with A and B of all basis vectors are updated along, so every iteration needs one multiplication with each
+    t_vec_c p, Ap, Bp;
+    t_dense_c S(nDof, 3), AS(nDof, 3), BS(nDof, 3);
+    int retVal = 2;
+    for(nIterations=0; nIterations<SCP_MAX_ITER; ++nIterations) {
+        const t_s lambda = std::real(x.dot(Ax));
+        const t_vec_c residual = Ax - lambda*Bx;
+        if(residual.norm() < SCP_EPS) {
+            retVal = 0;
+            break;
+        }
+        
+        t_vec_c w = ldlt.solve(residual);
+        t_vec_c Aw = A*w, Bw = B*w;
+        
+        //B-orthonormal basis of x, w, p. Nearly dependent directions are dropped.
+        //The mean is removed again after the orthogonalization, so that rounding cannot bring the constant kernel back.
+        int k = 0;
+        const auto add_direction = [&] (t_vec_c v, t_vec_c Av, t_vec_c Bv) {
+            project(v, Av, Bv);
+            const t_s originalNorm = std::sqrt(std::real(v.dot(Bv)));
+            if(!(originalNorm > 0))
+                return;
+            for(int l=0; l<k; ++l) {
+                const t_c c = BS.col(l).dot(v);
+                v -= c*S.col(l);
+                Av -= c*AS.col(l);
+                Bv -= c*BS.col(l);
+            }
+            project(v, Av, Bv);
+            const t_s norm = std::sqrt(std::real(v.dot(Bv)));
+            if(!(norm > 1e-8*originalNorm))
+                return;
+            S.col(k) = v/norm;
+            AS.col(k) = Av/norm;
+            BS.col(k) = Bv/norm;
+            ++k;
+        };
+        add_direction(x, Ax, Bx);
+        add_direction(w, Aw, Bw);
+        if(p.size() == nDof)
+            add_direction(p, Ap, Bp);
+        if(k < 2) {
+            //The preconditioned residual is in the span of x
+            retVal = 0;
+            break;
+        }
+        
+        //Rayleigh-Ritz on the basis
+        t_dense_c smallA = S.leftCols(k).adjoint() * AS.leftCols(k);
+        smallA = 0.5*(smallA + t_dense_c(smallA.adjoint()));
+        Eigen::SelfAdjointEigenSolver<t_dense_c> smallSolver(smallA);
+        const t_vec_c c = smallSolver.eigenvectors().col(0);
+        
+        p = S.middleCols(1, k-1) * c.tail(k-1);
+        Ap = AS.middleCols(1, k-1) * c.tail(k-1);
+        Bp = BS.middleCols(1, k-1) * c.tail(k-1);
+        x = c(0)*S.col(0) + p;
+        Ax = c(0)*AS.col(0) + Ap;
+        Bx = c(0)*BS.col(0) + Bp;
+    }
+    
+    y = x;
+    lastY = x;
+    
+    return retVal;
+}
+
+
+template <typename derivedV, typename derivedF, typename derivedUV>
+IGL_INLINE int scp_flatten_chart(const Eigen::PlainObjectBase<derivedV>& V,
+                                 const Eigen::PlainObjectBase<derivedF>& F,
+                                 Eigen::PlainObjectBase<derivedUV>& uv)
+{
+    typedef typename derivedV::Scalar t_s;
+    typedef Eigen::Matrix<t_s, 3, 1> t_V3;
+    typedef typename ScpSolver<t_s>::t_c t_c;
+    typedef typename ScpSolver<t_s>::t_sparse_c t_sparse_c;
+    typedef typename ScpSolver<t_s>::t_vec_c t_vec_c;
+    typedef Eigen::Triplet<t_c> t_triplet_c;
+    const t_c I(0, 1);
+    
+    const int nV = V.rows();
+    const int nF = F.rows();
+    
+    //Boundary halfedges are the ones whose opposite does not exist
+    std::vector<std::pair<int, int> > sortedHalfedges;
+    sortedHalfedges.reserve(3*nF);
+    for(int face=0; face<nF; ++face)
+        for(int j=0; j<3; ++j)
+            sortedHalfedges.emplace_back(F(face,j), F(face,(j+1)%3));
+    std::sort(sortedHalfedges.begin(), sortedHalfedges.end());
+    
+    //Same matrices as the single-chart SCP branch of flatten_cut, the area term is on every open halfedge,
+    //which are the cut edges and the boundary edges of the uncut mesh
+    std::vector<t_triplet_c> tripletListA, tripletListB;
+    tripletListA.reserve(18*nF + nV);
+    tripletListB.reserve(3*nF);
+    for(int face=0; face<nF; ++face) {
+        const t_V3 e1 = (V.row(F(face,1)) - V.row(F(face,0))).transpose();
+        const t_V3 e2 = (V.row(F(face,2)) - V.row(F(face,0))).transpose();
+        const t_s A = 0.5*e1.cross(e2).norm();
+        for(int j=0; j<3; ++j) {
+            const int i = F(face,j);
+            const int i1 = F(face,(j+1)%3);
+            const int i2 = F(face,(j+2)%3);
+            
+            const t_V3 a = (V.row(i1) - V.row(i)).transpose();
+            const t_V3 b = (V.row(i2) - V.row(i)).transpose();
+            const t_s cross = a.cross(b).norm();
+            const t_s cotanh = cross>0 ? a.dot(b)/cross : 0;
+            
+            tripletListA.emplace_back(i1, i2, -0.25*cotanh);
+            tripletListA.emplace_back(i2, i1, -0.25*cotanh);
+            tripletListA.emplace_back(i1, i1, 0.25*cotanh);
+            tripletListA.emplace_back(i2, i2, 0.25*cotanh);
+            if(!std::binary_search(sortedHalfedges.begin(), sortedHalfedges.end(), std::make_pair(i2, i1))) {
+                tripletListA.emplace_back(i1, i2, 0.25*I);
+                tripletListA.emplace_back(i2, i1, -0.25*I);
+            }
+            
+            tripletListB.emplace_back(i, i, 1./3.*A);
+        }
+    }
+    for(int i=0; i<nV; ++i)
+        tripletListA.emplace_back(i, i, 1e-8);
+    t_sparse_c A(nV, nV), B(nV, nV);
+    A.setFromTriplets(tripletListA.begin(), tripletListA.end());
+    B.setFromTriplets(tripletListB.begin(), tripletListB.end());
+    
+    ScpSolver<t_s> solver;
+    t_vec_c y;
+    const int retVal = solver.solve(A, B, y);
+    if(retVal == 1)
+        return retVal;
+    
+    uv.resize(nV, 2);
+    for(int i=0; i<nV; ++i) {
+        uv(i,0) = std::real(y(i));
+        uv(i,1) = std::imag(y(i));
+    }
+    
+    return 0;
+}
@@ -0,0 +1,91 @@
+/*
+
+ 2018, Oded Stein, Eitan Grinspun and Keenan Crane
+
+ This file is part of the code for "Developability of Triangle Meshes".
+
+ The code for "Developability of Triangle Meshes" is free software: you can
+ redistribute it and/or modify it under the terms of the GNU General Public
+ License as published by the Free Software Foundation, either version 2 of the
+ License, or (at your option) any later version.
+
+ The code for "Developability of Triangle Meshes" is distributed in the hope
+ that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with the code for "Developability of Triangle Meshes". If not,
+ see <https://www.gnu.org/licenses/>.
+
+ */
+
+
+#ifndef DEVELOPABLEFLOW_SCP_SOLVER_H
+#define DEVELOPABLEFLOW_SCP_SOLVER_H
+
+#include <igl/igl_inline.h>
+
+#include <Eigen/Core>
+#include <Eigen/Sparse>
+#include <Eigen/SparseCholesky>
+#include <complex>
+#include <vector>
+
+
+#define SCP_MAX_ITER 100
+#define SCP_EPS 1e-7
+
+
+//Smallest nonconstant eigenvector of the spectral conformal parameterization problem A y = lambda B y.
+//Kept between calls: if the sparsity pattern of A did not change, the symbolic analysis of the LDLT is reused and only
+//the numeric factorization is redone, and the previous eigenvector is the starting guess.
+//The eigenvector is found with LOBPCG (block of the iterate, the preconditioned residual and the previous step),
+//preconditioned with the factorization of A, which converges in far fewer iterations than inverse power iteration.
+template <typename t_s>
+class ScpSolver
+{
+public:
+    typedef std::complex<t_s> t_c;
+    typedef Eigen::SparseMatrix<t_c> t_sparse_c;
+    typedef Eigen::Matrix<t_c, Eigen::Dynamic, 1> t_vec_c;
+
+    IGL_INLINE ScpSolver();
+
+    //Forget the factorization and the last eigenvector
+    IGL_INLINE void reset();
+
+    //Returns 0 on success, 1 if the factorization failed, 2 if the iteration did not converge (y is still the best guess)
+    IGL_INLINE int solve(const t_sparse_c& A, //Hermitian positive definite conformal energy
+                         const t_sparse_c& B, //Diagonal mass matrix
+                         t_vec_c& y); //return value eigenvector, B-normalized and with zero mean
+
+    //Statistics of the last solve
+    IGL_INLINE int last_iterations() const;
+    IGL_INLINE bool last_reused_analysis() const;
+
+private:
+    IGL_INLINE bool same_pattern(const t_sparse_c& A) const;
+
+    Eigen::SimplicialLDLT<t_sparse_c> ldlt;
+    std::vector<typename t_sparse_c::StorageIndex> outerPattern, innerPattern; //pattern of the analyzed A
+    t_vec_c lastY;
+    int nIterations;
+    bool reusedAnalysis;
+};
+
+
+//Spectral conformal parameterization of a single connected chart, with the area term on the chart's own boundary.
+//Uses a fresh ScpSolver, so it can run for several charts at once.
+//Returns 0 on success, error code otherwise
+template <typename derivedV, typename derivedF, typename derivedUV>
+IGL_INLINE int scp_flatten_chart(const Eigen::PlainObjectBase<derivedV>& V, //Vertices of the chart
+                                 const Eigen::PlainObjectBase<derivedF>& F, //Faces of the chart
+                                 Eigen::PlainObjectBase<derivedUV>& uv); //return value uv coordinates, one row per vertex
+
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "scp_solver.cpp"
+#endif
+
+#endif
@@ -0,0 +1,128 @@
+/*
+
+ 2018, Oded Stein, Eitan Grinspun and Keenan Crane
+
+ This file is part of the code for "Developability of Triangle Meshes".
+
+ The code for "Developability of Triangle Meshes" is free software: you can
+ redistribute it and/or modify it under the terms of the GNU General Public
+ License as published by the Free Software Foundation, either version 2 of the
+ License, or (at your option) any later version.
+
+ The code for "Developability of Triangle Meshes" is distributed in the hope
+ that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with the code for "Developability of Triangle Meshes". If not,
+ see <https://www.gnu.org/licenses/>.
+
+ */
+
+
+#include "select_punctures.h"
+
+#include <tools/thread_pool.h>
+
+#include <igl/bounding_box_diagonal.h>
+
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+#include <cmath>
+
+
+template <typename derivedV, typename derivedEnergy, typename t_s, typename t_i>
+IGL_INLINE void select_punctures(const Eigen::PlainObjectBase<derivedV>& V,
+                                 const Eigen::PlainObjectBase<derivedEnergy>& energy,
+                                 const PunctureSelection<t_s>& selection,
+                                 std::vector<t_i>& punctureList)
+{
+    typedef typename derivedEnergy::Scalar t_energy_s;
+    typedef std::pair<t_energy_s, t_i> t_candidate;
+    
+    const t_i nV = energy.size();
+    punctureList.clear();
+    
+    //Candidates above the threshold, collected per thread
+    std::vector<std::vector<t_candidate> > threadCandidates;
+    std::vector<t_candidate> candidates;
+    const auto prep_candidates = [&threadCandidates] (const int& threadNum) {
+        threadCandidates.assign(threadNum, std::vector<t_candidate>());
+    };
+    const auto collect_candidate = [&] (const int& vert, const int& thread) {
+        if(energy(vert) > selection.threshold)
+            threadCandidates[thread].emplace_back(energy(vert), vert);
+    };
+    const auto accum_candidates = [&] (const int& thread) {
+        candidates.insert(candidates.end(), threadCandidates[thread].begin(), threadCandidates[thread].end());
+    };
+    
+#ifndef PARALLEL_COMPUTATION
+    //SERIAL VERSION
+    prep_candidates(1);
+    for(int vert=0; vert<nV; ++vert)
+        collect_candidate(vert, 0);
+    accum_candidates(0);
+#else
+    //PARALLEL VERSION
+    solver_parallel_for(nV, prep_candidates, collect_candidate, accum_candidates);
+#endif
+    
+    //The candidates are a top segment of the vertices ordered by energy, so the percentile and top-k cuts only shorten it
+    t_i nKeep = nV - (t_i)std::floor(selection.percentile*nV);
+    //A mesh whose bounding box has no extent gives no radius to thin with, that is treated as no thinning
+    const t_s radius = selection.spacing > 0 && nV > 0 ? selection.spacing*igl::bounding_box_diagonal(V) : t_s(0);
+    const bool thinning = radius > 0;
+    if(selection.topK > 0 && !thinning)
+        nKeep = std::min(nKeep, (t_i)selection.topK);
+    nKeep = std::max((t_i)0, std::min(nKeep, (t_i)candidates.size()));
+    
+    //Partition the nKeep highest candidates to the front and sort only those, highest first
+    std::nth_element(candidates.begin(), candidates.begin()+nKeep, candidates.end(), std::greater<t_candidate>());
+    candidates.resize(nKeep);
+    std::sort(candidates.begin(), candidates.end(), std::greater<t_candidate>());
+    
+    if(thinning && nKeep > 0) {
+        //Greedy Poisson-disk thinning with a uniform grid of cell size radius, the top-k cut applies to the thinned list
+        const t_s radiusSq = radius*radius;
+        const auto cell_coordinate = [radius] (const t_s& x) {
+            return (long long)std::floor(x/radius);
+        };
+        const auto cell_key = [] (const long long& x, const long long& y, const long long& z) {
+            return (x*73856093LL) ^ (y*19349663LL) ^ (z*83492791LL);
+        };
+        std::unordered_map<long long, std::vector<t_i> > grid;
+        std::vector<t_candidate> kept;
+        for(const t_candidate& candidate : candidates) {
+            const t_i& vert = candidate.second;
+            const long long cx = cell_coordinate(V(vert,0)), cy = cell_coordinate(V(vert,1)), cz = cell_coordinate(V(vert,2));
+            bool tooClose = false;
+            for(long long dx=-1; dx<=1 && !tooClose; ++dx)
+                for(long long dy=-1; dy<=1 && !tooClose; ++dy)
+                    for(long long dz=-1; dz<=1 && !tooClose; ++dz) {
+                        const auto cell = grid.find(cell_key(cx+dx, cy+dy, cz+dz));
+                        if(cell == grid.end())
+                            continue;
+                        for(const t_i& other : cell->second)
+                            if((V.row(vert)-V.row(other)).squaredNorm() < radiusSq) {
+                                tooClose = true;
+                                break;
+                            }
+                    }
+            if(!tooClose) {
+                grid[cell_key(cx, cy, cz)].push_back(vert);
+                kept.push_back(candidate);
+                if(selection.topK > 0 && (int)kept.size() == selection.topK)
+                    break;
+            }
+        }
+        candidates.swap(kept);
+    }
+    
+    punctureList.reserve(candidates.size());
+    for(auto candidate=candidates.rbegin(); candidate!=candidates.rend(); ++candidate)
+        punctureList.push_back(candidate->second);
+}
@@ -0,0 +1,61 @@
+/*
+
+ 2018, Oded Stein, Eitan Grinspun and Keenan Crane
+
+ This file is part of the code for "Developability of Triangle Meshes".
+
+ The code for "Developability of Triangle Meshes" is free software: you can
+ redistribute it and/or modify it under the terms of the GNU General Public
+ License as published by the Free Software Foundation, either version 2 of the
+ License, or (at your option) any later version.
+
+ The code for "Developability of Triangle Meshes" is distributed in the hope
+ that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with the code for "Developability of Triangle Meshes". If not,
+ see <https://www.gnu.org/licenses/>.
+
+ */
+
+
+#ifndef DEVELOPABLEFLOW_SELECT_PUNCTURES_H
+#define DEVELOPABLEFLOW_SELECT_PUNCTURES_H
+
+#include <igl/igl_inline.h>
+
+#include <Eigen/Core>
+#include <vector>
+#include <limits>
+
+
+//Which vertices become punctures. All criteria are applied together, the defaults select every vertex.
+template <typename t_s>
+struct PunctureSelection
+{
+    t_s percentile = 0; //fraction of the vertices with the lowest energy that are never punctured
+    int topK = 0; //at most this many punctures (after thinning), 0 for no limit
+    t_s threshold = -std::numeric_limits<t_s>::infinity(); //only vertices with energy above this are punctured
+    t_s spacing = 0; //Poisson-disk thinning: no two punctures closer than this times the bounding box diagonal, 0 for no thinning
+};
+
+
+//Select the puncture vertices with the highest energy according to selection.
+//Uses a partial selection (nth_element) on the vertices above the threshold instead of sorting all of them.
+//Thinning keeps the highest energy vertex of every cluster, greedily in order of decreasing energy.
+//punctureList is sorted by increasing energy.
+template <typename derivedV, typename derivedEnergy, typename t_s, typename t_i>
+IGL_INLINE void select_punctures(const Eigen::PlainObjectBase<derivedV>& V, //Vertices
+                                 const Eigen::PlainObjectBase<derivedEnergy>& energy, //Per-vertex energy
+                                 const PunctureSelection<t_s>& selection, //Selection policy
+                                 std::vector<t_i>& punctureList); //return value list of puncture vertices
+
+
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "select_punctures.cpp"
+#endif
+
+#endif
@@ -48,12 +48,12 @@
 #define INFTY std::numeric_limits<double>::infinity()
 
 
-template <typename derivedV, typename derivedF, typename indexType, typename derivedEnergy, typename derivedEnergyGrad, typename derivedT, typename derivedP>
+template <typename derivedV, typename derivedF, typename indexType, typename cornerType, typename derivedEnergy, typename derivedEnergyGrad, typename derivedT, typename derivedP>
 IGL_INLINE int hinge_timestep(
                               Eigen::PlainObjectBase<derivedV>& V,
                               const Eigen::PlainObjectBase<derivedF>& F,
                               const std::vector<std::vector<indexType> >& VF,
-                              const std::vector<std::vector<indexType> >& VFi,
+                              const std::vector<std::vector<cornerType> >& VFi,
                               const std::vector<bool>& isB,
                               derivedT& t,
                               Eigen::PlainObjectBase<derivedP>& p,
@@ -65,12 +65,12 @@ IGL_INLINE int hinge_timestep(
     return timestep_tool(V, F, VF, VFi, isB, t, p, energy, energyGrad, mode, type, ENERGY_TYPE_HINGE);
 }
 
-template <typename derivedV, typename derivedF, typename indexType, typename derivedEnergy, typename derivedEnergyGrad, typename derivedT, typename derivedP>
+template <typename derivedV, typename derivedF, typename indexType, typename cornerType, typename derivedEnergy, typename derivedEnergyGrad, typename derivedT, typename derivedP>
 IGL_INLINE int minwidth_timestep(
                                  Eigen::PlainObjectBase<derivedV>& V,
                                  const Eigen::PlainObjectBase<derivedF>& F,
                                  const std::vector<std::vector<indexType> >& VF,
-                                 const std::vector<std::vector<indexType> >& VFi,
+                                 const std::vector<std::vector<cornerType> >& VFi,
                                  const std::vector<bool>& isB,
                                  derivedT& t,
                                  Eigen::PlainObjectBase<derivedP>& p,
@@ -83,12 +83,12 @@ IGL_INLINE int minwidth_timestep(
 }
 
 
-template <typename derivedV, typename derivedF, typename indexType, typename derivedEnergy, typename derivedEnergyGrad, typename derivedT, typename derivedP>
+template <typename derivedV, typename derivedF, typename indexType, typename cornerType, typename derivedEnergy, typename derivedEnergyGrad, typename derivedT, typename derivedP>
 IGL_INLINE int timestep(
                         Eigen::PlainObjectBase<derivedV>& V,
                         const Eigen::PlainObjectBase<derivedF>& F,
                         const std::vector<std::vector<indexType> >& VF,
-                        const std::vector<std::vector<indexType> >& VFi,
+                        const std::vector<std::vector<cornerType> >& VFi,
                         const std::vector<bool>& isB,
                         derivedT& t,
                         Eigen::PlainObjectBase<derivedP>& p,
@@ -99,19 +99,19 @@ IGL_INLINE int timestep(
                         EnergyType energyType)
 {
     typedef typename derivedV::Scalar t_V_s;
-    typedef Eigen::Matrix<t_V_s, Eigen::Dynamic, 3> t_V;
+    typedef Eigen::Matrix<t_V_s, Eigen::Dynamic, 3, (derivedV::IsRowMajor ? Eigen::RowMajor : Eigen::ColMajor)> t_V;
     typedef Eigen::Matrix<t_V_s, Eigen::Dynamic, 1> t_Vv;
     typedef Eigen::Matrix<t_V_s, 1, 3> t_V3;
     typedef typename derivedF::Scalar t_F_i;
-    typedef Eigen::Matrix<t_F_i, Eigen::Dynamic, 3> t_F;
+    typedef Eigen::Matrix<t_F_i, Eigen::Dynamic, 3, (derivedF::IsRowMajor ? Eigen::RowMajor : Eigen::ColMajor)> t_F;
     typedef Eigen::Matrix<t_F_i, Eigen::Dynamic, 1> t_Fv;
     typedef typename derivedP::Scalar t_p_s;
-    typedef Eigen::Matrix<t_p_s, Eigen::Dynamic, 3> t_p;
+    typedef Eigen::Matrix<t_p_s, Eigen::Dynamic, 3, (derivedP::IsRowMajor ? Eigen::RowMajor : Eigen::ColMajor)> t_p;
     typedef Eigen::Matrix<t_p_s, 1, 3> t_p3;
     typedef typename derivedEnergy::Scalar t_energy_s;
     typedef Eigen::Matrix<t_energy_s, Eigen::Dynamic, 1> t_energy;
     typedef typename derivedEnergyGrad::Scalar t_energyGrad_s;
-    typedef Eigen::Matrix<t_energyGrad_s, Eigen::Dynamic, 3> t_energyGrad;
+    typedef Eigen::Matrix<t_energyGrad_s, Eigen::Dynamic, 3, (derivedEnergyGrad::IsRowMajor ? Eigen::RowMajor : Eigen::ColMajor)> t_energyGrad;
     typedef Eigen::Matrix<t_energyGrad_s, 1, 3> t_energyGrad3;
     
     
@@ -48,12 +48,12 @@ enum StepType {
 };
 
 
-template <typename derivedV, typename derivedF, typename indexType, typename derivedEnergy, typename derivedEnergyGrad, typename derivedT, typename derivedP>
+template <typename derivedV, typename derivedF, typename indexType, typename cornerType, typename derivedEnergy, typename derivedEnergyGrad, typename derivedT, typename derivedP>
 IGL_INLINE int hinge_timestep(
                         Eigen::PlainObjectBase<derivedV>& V, //Vertices
                         const Eigen::PlainObjectBase<derivedF>& F, //TT from triangle_triangle_adjacency
                         const std::vector<std::vector<indexType> >& VF, //VF from vertex-triangle adjacency
-                        const std::vector<std::vector<indexType> >& VFi, //VFi from vertex-triangle adjacency
+                        const std::vector<std::vector<cornerType> >& VFi, //VFi from vertex-triangle adjacency
                         const std::vector<bool>& isB, //isB from is_border_vertex
                         derivedT& t, //initial time guess, contains actual time step at the end
                         Eigen::PlainObjectBase<derivedP>& p, //search direction, will be updated with new search direction in the end
@@ -62,12 +62,12 @@ IGL_INLINE int hinge_timestep(
                         Linesearch mode = LINESEARCH_NONE, //the type of line search to use
                         StepType type = STEP_TYPE_GRADDESC); //Which step method to use.
 
-template <typename derivedV, typename derivedF, typename indexType, typename derivedEnergy, typename derivedEnergyGrad, typename derivedT, typename derivedP>
+template <typename derivedV, typename derivedF, typename indexType, typename cornerType, typename derivedEnergy, typename derivedEnergyGrad, typename derivedT, typename derivedP>
 IGL_INLINE int minwidth_timestep(
                                  Eigen::PlainObjectBase<derivedV>& V, //Vertices
                                  const Eigen::PlainObjectBase<derivedF>& F, //TT from triangle_triangle_adjacency
                                  const std::vector<std::vector<indexType> >& VF, //VF from vertex-triangle adjacency
-                                 const std::vector<std::vector<indexType> >& VFi, //VFi from vertex-triangle adjacency
+                                 const std::vector<std::vector<cornerType> >& VFi, //VFi from vertex-triangle adjacency
                                  const std::vector<bool>& isB, //isB from is_border_vertex
                                  derivedT& t, //initial time guess, contains actual time step at the end
                                  Eigen::PlainObjectBase<derivedP>& p, //search direction, will be updated with new search direction in the end
@@ -77,12 +77,12 @@ IGL_INLINE int minwidth_timestep(
                                  StepType type = STEP_TYPE_GRADDESC); //Which step method to use.
 
 
-template <typename derivedV, typename derivedF, typename indexType, typename derivedEnergy, typename derivedEnergyGrad, typename derivedT, typename derivedP>
+template <typename derivedV, typename derivedF, typename indexType, typename cornerType, typename derivedEnergy, typename derivedEnergyGrad, typename derivedT, typename derivedP>
 IGL_INLINE int timestep(
                              Eigen::PlainObjectBase<derivedV>& V, //Vertices
                              const Eigen::PlainObjectBase<derivedF>& F, //TT from triangle_triangle_adjacency
                              const std::vector<std::vector<indexType> >& VF, //VF from vertex-triangle adjacency
-                             const std::vector<std::vector<indexType> >& VFi, //VFi from vertex-triangle adjacency
+                             const std::vector<std::vector<cornerType> >& VFi, //VFi from vertex-triangle adjacency
                              const std::vector<bool>& isB, //isB from is_border_vertex
                              derivedT& t, //initial time guess, contains actual time step at the end
                              Eigen::PlainObjectBase<derivedP>& p, //search direction, will be updated with new search direction in the end
@@ -0,0 +1,167 @@
+/*
+ 
+ 2018, Oded Stein, Eitan Grinspun and Keenan Crane
+ 
+ This file is part of the code for "Developability of Triangle Meshes".
+ 
+ The code for "Developability of Triangle Meshes" is free software: you can
+ redistribute it and/or modify it under the terms of the GNU General Public
+ License as published by the Free Software Foundation, either version 2 of the
+ License, or (at your option) any later version.
+ 
+ The code for "Developability of Triangle Meshes" is distributed in the hope
+ that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with the code for "Developability of Triangle Meshes". If not,
+ see <https://www.gnu.org/licenses/>.
+ 
+ */
+
+
+#include "async_exporter.h"
+
+#include <tools/mesh_writer.h>
+#include <tools/write_cut_meshes.h>
+
+
+template <typename derived>
+IGL_INLINE ExportMatrix export_snapshot(const Eigen::MatrixBase<derived>& A)
+{
+    return std::make_shared<const Eigen::MatrixXd>(A.template cast<double>());
+}
+
+
+template <typename derived>
+IGL_INLINE ExportIndices export_snapshot_indices(const Eigen::MatrixBase<derived>& A)
+{
+    return std::make_shared<const ExportIndexMatrix>(A.template cast<std::int64_t>());
+}
+
+
+IGL_INLINE size_t export_bytes(const ExportMatrix& A)
+{
+    return A ? A->size()*sizeof(double) : 0;
+}
+
+
+IGL_INLINE size_t export_bytes(const ExportIndices& A)
+{
+    return A ? A->size()*sizeof(std::int64_t) : 0;
+}
+
+
+
+IGL_INLINE AsyncExporter::AsyncExporter(const size_t& iBudget) :
+budget(iBudget), queuedBytes(0), nPending(0), nFailures(0), stopping(false)
+{
+    writer = std::thread(&AsyncExporter::writer_loop, this);
+}
+
+
+IGL_INLINE AsyncExporter::~AsyncExporter()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeCondition.notify_one();
+    writer.join();
+}
+
+
+IGL_INLINE bool AsyncExporter::export_job(const std::function<bool()>& write, const size_t& bytes, const bool& wait)
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        //A job larger than the whole budget is let through once the queue is empty
+        const auto has_room = [this, &bytes] { return queuedBytes==0 || queuedBytes+bytes <= budget; };
+        if(!has_room()) {
+            if(!wait)
+                return false;
+            doneCondition.wait(lock, has_room);
+        }
+        jobs.push_back(Job{write, bytes});
+        queuedBytes += bytes;
+        ++nPending;
+    }
+    wakeCondition.notify_one();
+    return true;
+}
+
+
+IGL_INLINE bool AsyncExporter::export_mesh(const std::string& filename, const ExportMatrix& V, const ExportIndices& F, const bool& wait)
+{
+    const bool ply = filename.size()>=4 && filename.compare(filename.size()-4, 4, ".ply")==0;
+    return export_job([filename, V, F, ply] {
+        return ply ? write_ply_binary(filename, *V, *F) : write_obj_buffered(filename, *V, *F);
+    }, export_bytes(V)+export_bytes(F), wait);
+}
+
+
+IGL_INLINE bool AsyncExporter::export_cut_meshes(const ExportMatrix& V, const ExportIndices& F, const ExportMatrix& flatV, const ExportIndices& flatF,
+                                                 const std::string& filename1, const std::string& filename2, const bool& wait)
+{
+    return export_job([V, F, flatV, flatF, filename1, filename2] {
+        return write_cut_meshes(*V, *F, *flatV, *flatF, filename1, filename2);
+    }, export_bytes(V)+export_bytes(F)+export_bytes(flatV)+export_bytes(flatF), wait);
+}
+
+
+IGL_INLINE void AsyncExporter::flush()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    doneCondition.wait(lock, [this] { return nPending==0; });
+}
+
+
+IGL_INLINE size_t AsyncExporter::pending()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return nPending;
+}
+
+
+IGL_INLINE size_t AsyncExporter::failures()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return nFailures;
+}
+
+
+IGL_INLINE void AsyncExporter::writer_loop()
+{
+    while(true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeCondition.wait(lock, [this] { return stopping || !jobs.empty(); });
+            if(jobs.empty())
+                return;
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+
+        const bool success = job.write();
+        //Drop the snapshots before the budget is given back
+        job.write = nullptr;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            queuedBytes -= job.bytes;
+            --nPending;
+            if(!success)
+                ++nFailures;
+        }
+        doneCondition.notify_all();
+    }
+}
+
+
+IGL_INLINE AsyncExporter& async_exporter()
+{
+    static AsyncExporter exporter;
+    return exporter;
+}
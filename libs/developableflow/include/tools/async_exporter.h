@@ -0,0 +1,124 @@
+/*
+ 
+ 2018, Oded Stein, Eitan Grinspun and Keenan Crane
+ 
+ This file is part of the code for "Developability of Triangle Meshes".
+ 
+ The code for "Developability of Triangle Meshes" is free software: you can
+ redistribute it and/or modify it under the terms of the GNU General Public
+ License as published by the Free Software Foundation, either version 2 of the
+ License, or (at your option) any later version.
+ 
+ The code for "Developability of Triangle Meshes" is distributed in the hope
+ that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with the code for "Developability of Triangle Meshes". If not,
+ see <https://www.gnu.org/licenses/>.
+ 
+ */
+
+
+#ifndef DEVELOPABLEFLOW_ASYNC_EXPORTER_H
+#define DEVELOPABLEFLOW_ASYNC_EXPORTER_H
+
+#include <igl/igl_inline.h>
+
+#include <Eigen/Core>
+#include <memory>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+
+//Bytes of snapshots that may wait in the queue before export() waits for the writer
+#define ASYNC_EXPORT_BUDGET (size_t(512)<<20)
+
+
+//Immutable copy of a matrix that any number of queued exports can share.
+//Indices are kept at 64 bits, so meshes with 64 bit indices are not truncated.
+typedef Eigen::Matrix<std::int64_t, Eigen::Dynamic, Eigen::Dynamic> ExportIndexMatrix;
+typedef std::shared_ptr<const Eigen::MatrixXd> ExportMatrix;
+typedef std::shared_ptr<const ExportIndexMatrix> ExportIndices;
+
+//Also takes Eigen::Map, e.g. of the ofMesh buffers
+template <typename derived>
+IGL_INLINE ExportMatrix export_snapshot(const Eigen::MatrixBase<derived>& A);
+template <typename derived>
+IGL_INLINE ExportIndices export_snapshot_indices(const Eigen::MatrixBase<derived>& A);
+
+
+//Runs exports on one background I/O thread, so the solver and the viewer never wait for the disk.
+//The caller takes snapshots of what it wants written and hands them over; snapshots are never modified after that,
+//so several exports of the same result share one copy, and the solver can keep changing its own matrices.
+//The snapshots of queued exports may take up at most budget bytes. Beyond that, export() either waits
+//until enough has been written or drops the export, depending on wait.
+class AsyncExporter
+{
+public:
+    IGL_INLINE AsyncExporter(const size_t& budget = ASYNC_EXPORT_BUDGET);
+    //Finishes all queued exports
+    IGL_INLINE ~AsyncExporter();
+
+    //Queue write(), which must only use data it owns. bytes is what it keeps alive.
+    //Returns false if the export was dropped because the budget was full and wait is false.
+    IGL_INLINE bool export_job(const std::function<bool()>& write, //Writes the file, returns false on failure
+                               const size_t& bytes, //Memory held by the job
+                               const bool& wait = true); //Wait for room instead of dropping the export
+
+    //Mesh as OBJ, or binary PLY if the filename ends in .ply
+    IGL_INLINE bool export_mesh(const std::string& filename, //file to write
+                                const ExportMatrix& V, //Vertices
+                                const ExportIndices& F, //Faces
+                                const bool& wait = true); //Wait for room instead of dropping the export
+
+    //write_cut_meshes with snapshots
+    IGL_INLINE bool export_cut_meshes(const ExportMatrix& V, //Vertices
+                                      const ExportIndices& F, //Faces
+                                      const ExportMatrix& flatV, //Flattened vertices
+                                      const ExportIndices& flatF, //Flattened faces
+                                      const std::string& filename1, //file to write the output 1 to
+                                      const std::string& filename2, //file to write the output 2 to
+                                      const bool& wait = true); //Wait for room instead of dropping the export
+
+    //Block until every queued export is written
+    IGL_INLINE void flush();
+
+    //Exports queued or being written, and exports that failed so far
+    IGL_INLINE size_t pending();
+    IGL_INLINE size_t failures();
+
+private:
+    struct Job {
+        std::function<bool()> write;
+        size_t bytes;
+    };
+
+    IGL_INLINE void writer_loop();
+
+    size_t budget, queuedBytes, nPending, nFailures;
+    std::deque<Job> jobs;
+    std::mutex mutex;
+    std::condition_variable wakeCondition, doneCondition;
+    bool stopping;
+    std::thread writer;
+};
+
+
+//The exporter shared by the application
+IGL_INLINE AsyncExporter& async_exporter();
+
+
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "async_exporter.cpp"
+#endif
+
+#endif
@@ -0,0 +1,180 @@
+/*
+ 
+ 2018, Oded Stein, Eitan Grinspun and Keenan Crane
+ 
+ This file is part of the code for "Developability of Triangle Meshes".
+ 
+ The code for "Developability of Triangle Meshes" is free software: you can
+ redistribute it and/or modify it under the terms of the GNU General Public
+ License as published by the Free Software Foundation, either version 2 of the
+ License, or (at your option) any later version.
+ 
+ The code for "Developability of Triangle Meshes" is distributed in the hope
+ that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with the code for "Developability of Triangle Meshes". If not,
+ see <https://www.gnu.org/licenses/>.
+ 
+ */
+
+
+#include "distortion_metrics.h"
+
+#include <tools/thread_pool.h>
+
+#include <Eigen/Geometry>
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+
+//Faces per block of the vectorized pass
+#define DISTORTION_BLOCK 1024
+
+
+template <typename derivedV, typename derivedF, typename derivedUV, typename derivedUVF, typename derivedErr, typename t_s>
+IGL_INLINE void distortion_metrics(const Eigen::PlainObjectBase<derivedV>& V,
+                                   const Eigen::PlainObjectBase<derivedF>& F,
+                                   const Eigen::PlainObjectBase<derivedUV>& UV,
+                                   const Eigen::PlainObjectBase<derivedUVF>& UVF,
+                                   Eigen::PlainObjectBase<derivedErr>& conformal,
+                                   Eigen::PlainObjectBase<derivedErr>& area,
+                                   Eigen::PlainObjectBase<derivedErr>& stretch,
+                                   DistortionStats<t_s>& stats)
+{
+    typedef typename derivedErr::Scalar t_err_s;
+    typedef Eigen::Matrix<t_s, 3, 1> t_V3;
+    
+    const int nF = F.rows();
+    conformal.resize(nF);
+    area.resize(nF);
+    stretch.resize(nF);
+    
+    //Gather every triangle into its own 2D frame, (0,0), (x1,0), (x2,y2), one array per coordinate
+    std::vector<t_s> px1(nF), px2(nF), py2(nF), qx1(nF), qx2(nF), qy2(nF), weight(nF);
+    std::vector<int> flipped(nF);
+    const auto local_frame = [] (const t_V3& u1, const t_V3& u2, t_s& x1, t_s& x2, t_s& y2) {
+        x1 = u1.norm();
+        x2 = u2.dot(u1)/x1;
+        y2 = u1.cross(u2).norm()/x1;
+    };
+    const auto gather_face = [&] (const int& face) {
+        const t_V3 u1 = (V.row(F(face,1)) - V.row(F(face,0))).template cast<t_s>().transpose();
+        const t_V3 u2 = (V.row(F(face,2)) - V.row(F(face,0))).template cast<t_s>().transpose();
+        t_V3 v1 = t_V3::Zero(), v2 = t_V3::Zero();
+        for(int k=0; k<std::min<int>(3, UV.cols()); ++k) {
+            v1(k) = UV(UVF(face,1),k) - UV(UVF(face,0),k);
+            v2(k) = UV(UVF(face,2),k) - UV(UVF(face,0),k);
+        }
+        local_frame(u1, u2, px1[face], px2[face], py2[face]);
+        local_frame(v1, v2, qx1[face], qx2[face], qy2[face]);
+        weight[face] = 0.5*px1[face]*py2[face];
+        flipped[face] = v1(0)*v2(1) - v1(1)*v2(0) > 0 ? 0 : 1;
+    };
+    
+    //The parameterization is scaled to the 3D surface area first, so area and stretch do not depend on its overall scale
+    t_s uvScale = 1;
+    
+    //Singular values of the Jacobian J = [a b; 0 d] in closed form, no branches
+    t_err_s* conformalData = conformal.data();
+    t_err_s* areaData = area.data();
+    t_err_s* stretchData = stretch.data();
+    const int nBlocks = (nF + DISTORTION_BLOCK - 1) / DISTORTION_BLOCK;
+    std::vector<DistortionStats<t_s> > threadStats;
+    std::vector<t_s> threadWeights;
+    const auto prep_stats = [&] (const int& threadNum) {
+        DistortionStats<t_s> zero = {0, 0, 0, 0, 0, 0, 0};
+        threadStats.assign(threadNum, zero);
+        threadWeights.assign(threadNum, 0);
+    };
+    const auto area_scale = [&] () {
+        t_s area3D = 0, areaUV = 0;
+        for(int face=0; face<nF; ++face) {
+            area3D += weight[face];
+            areaUV += 0.5*qx1[face]*qy2[face];
+        }
+        if(areaUV > 0)
+            uvScale = std::sqrt(area3D/areaUV);
+    };
+    const auto metrics_block = [&] (const int& block, const int& thread) {
+        const int begin = block*DISTORTION_BLOCK;
+        const int end = std::min(nF, begin + DISTORTION_BLOCK);
+        t_s w = 0, sumConformal = 0, sumArea = 0, sumStretch = 0;
+        t_s maxConformal = 0, maxArea = 0, maxStretch = 0;
+        int nFlipped = 0;
+        for(int face=begin; face<end; ++face) {
+            const t_s a = uvScale*qx1[face]/px1[face];
+            const t_s b = (uvScale*qx2[face] - a*px2[face])/py2[face];
+            const t_s d = uvScale*qy2[face]/py2[face];
+            const t_s E = 0.5*(a+d), G = 0.5*(a-d), H = 0.5*b;
+            const t_s Q = std::sqrt(E*E + H*H);
+            const t_s R = std::sqrt(G*G + H*H);
+            const t_s s1 = Q + R;
+            const t_s s2 = std::abs(Q - R);
+            const t_s c = s1/s2;
+            const t_s ar = std::abs(1. - s1*s2);
+            const t_s st = std::max(s1, 1./s1) + std::max(s2, 1./s2) + 1.;
+            conformalData[face] = c;
+            areaData[face] = ar;
+            stretchData[face] = st;
+            
+            w += weight[face];
+            sumConformal += weight[face]*c;
+            sumArea += weight[face]*ar;
+            sumStretch += weight[face]*st;
+            maxConformal = std::max(maxConformal, c);
+            maxArea = std::max(maxArea, ar);
+            maxStretch = std::max(maxStretch, st);
+            nFlipped += flipped[face];
+        }
+        
+        DistortionStats<t_s>& s = threadStats[thread];
+        s.meanConformal += sumConformal;
+        s.meanArea += sumArea;
+        s.meanStretch += sumStretch;
+        s.maxConformal = std::max(s.maxConformal, maxConformal);
+        s.maxArea = std::max(s.maxArea, maxArea);
+        s.maxStretch = std::max(s.maxStretch, maxStretch);
+        s.flipped += nFlipped;
+        threadWeights[thread] += w;
+    };
+    
+#ifndef PARALLEL_COMPUTATION
+    //SERIAL VERSION
+    for(int face=0; face<nF; ++face)
+        gather_face(face);
+    area_scale();
+    prep_stats(1);
+    for(int block=0; block<nBlocks; ++block)
+        metrics_block(block, 0);
+#else
+    //PARALLEL VERSION
+    solver_parallel_for(nF, gather_face);
+    area_scale();
+    solver_parallel_for(nBlocks, prep_stats, metrics_block, [] (const int&) {}, 2);
+#endif
+    
+    //Combine the threads
+    stats = {0, 0, 0, 0, 0, 0, 0};
+    t_s totalWeight = 0;
+    for(size_t t=0; t<threadStats.size(); ++t) {
+        const DistortionStats<t_s>& s = threadStats[t];
+        stats.meanConformal += s.meanConformal;
+        stats.meanArea += s.meanArea;
+        stats.meanStretch += s.meanStretch;
+        stats.maxConformal = std::max(stats.maxConformal, s.maxConformal);
+        stats.maxArea = std::max(stats.maxArea, s.maxArea);
+        stats.maxStretch = std::max(stats.maxStretch, s.maxStretch);
+        stats.flipped += s.flipped;
+        totalWeight += threadWeights[t];
+    }
+    if(totalWeight > 0) {
+        stats.meanConformal /= totalWeight;
+        stats.meanArea /= totalWeight;
+        stats.meanStretch /= totalWeight;
+    }
+}
@@ -0,0 +1,64 @@
+/*
+ 
+ 2018, Oded Stein, Eitan Grinspun and Keenan Crane
+ 
+ This file is part of the code for "Developability of Triangle Meshes".
+ 
+ The code for "Developability of Triangle Meshes" is free software: you can
+ redistribute it and/or modify it under the terms of the GNU General Public
+ License as published by the Free Software Foundation, either version 2 of the
+ License, or (at your option) any later version.
+ 
+ The code for "Developability of Triangle Meshes" is distributed in the hope
+ that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with the code for "Developability of Triangle Meshes". If not,
+ see <https://www.gnu.org/licenses/>.
+ 
+ */
+
+
+#ifndef DEVELOPABLEFLOW_DISTORTION_METRICS_H
+#define DEVELOPABLEFLOW_DISTORTION_METRICS_H
+
+#include <igl/igl_inline.h>
+
+#include <Eigen/Core>
+
+
+//Aggregates of distortion_metrics, means are weighted by the 3D face area
+template <typename t_s>
+struct DistortionStats
+{
+    t_s meanConformal, maxConformal;
+    t_s meanArea, maxArea;
+    t_s meanStretch, maxStretch;
+    int flipped; //faces whose uv triangle is not counterclockwise
+};
+
+
+//Per-face distortion of a parameterization, from the singular values s1 >= s2 of the 2x2 Jacobian of every face:
+//conformal s1/s2 (quasi-conformal distortion), area |1 - s1*s2|, stretch max(s1,1/s1) + max(s2,1/s2) + 1.
+//UV is scaled to the total 3D area of V, F beforehand, so none of the metrics depend on the scale of the parameterization.
+//The triangles are first gathered into flat per-coordinate arrays and the metrics are then computed in one branch-free loop,
+//both in parallel over the faces.
+template <typename derivedV, typename derivedF, typename derivedUV, typename derivedUVF, typename derivedErr, typename t_s>
+IGL_INLINE void distortion_metrics(const Eigen::PlainObjectBase<derivedV>& V, //Vertices
+                                   const Eigen::PlainObjectBase<derivedF>& F, //Faces
+                                   const Eigen::PlainObjectBase<derivedUV>& UV, //Parameterization, z is ignored for the orientation
+                                   const Eigen::PlainObjectBase<derivedUVF>& UVF, //Faces of the parameterization, same order as F
+                                   Eigen::PlainObjectBase<derivedErr>& conformal, //return value conformal distortion per face
+                                   Eigen::PlainObjectBase<derivedErr>& area, //return value area distortion per face
+                                   Eigen::PlainObjectBase<derivedErr>& stretch, //return value stretch per face
+                                   DistortionStats<t_s>& stats); //return value aggregates
+
+
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "distortion_metrics.cpp"
+#endif
+
+#endif
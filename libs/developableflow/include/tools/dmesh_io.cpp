@@ -0,0 +1,237 @@
+/*
+ 
+ 2018, Oded Stein, Eitan Grinspun and Keenan Crane
+ 
+ This file is part of the code for "Developability of Triangle Meshes".
+ 
+ The code for "Developability of Triangle Meshes" is free software: you can
+ redistribute it and/or modify it under the terms of the GNU General Public
+ License as published by the Free Software Foundation, either version 2 of the
+ License, or (at your option) any later version.
+ 
+ The code for "Developability of Triangle Meshes" is distributed in the hope
+ that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with the code for "Developability of Triangle Meshes". If not,
+ see <https://www.gnu.org/licenses/>.
+ 
+ */
+
+
+#include "dmesh_io.h"
+
+#include <tools/mapped_file.h>
+#include <tools/thread_pool.h>
+
+#include <fstream>
+#include <cstring>
+#include <type_traits>
+
+
+//Row-major on-disk matrix types
+template <typename t_s, int cols>
+using DMeshArray = Eigen::Matrix<t_s, Eigen::Dynamic, cols, (cols==1 ? Eigen::ColMajor : Eigen::RowMajor)>;
+
+
+IGL_INLINE std::uint64_t dmesh_fnv1a(const char* data, const size_t& n, std::uint64_t hash = 14695981039346656037ull)
+{
+    for(size_t i=0; i<n; ++i) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+
+//Size of an array in the file, padded to 8 bytes
+IGL_INLINE size_t dmesh_padded(const size_t& bytes)
+{
+    return (bytes+7) & ~size_t(7);
+}
+
+
+IGL_INLINE bool dmesh_file_hash(const std::string& filename, std::uint64_t& hash)
+{
+    MappedFile file;
+    if(!file.open(filename))
+        return false;
+
+    const int nChunks = (file.size()+DMESH_HASH_CHUNK-1)/DMESH_HASH_CHUNK;
+    std::vector<std::uint64_t> chunkHashes(nChunks);
+    const auto hash_chunk = [&] (const int& chunk) {
+        const size_t begin = size_t(chunk)*DMESH_HASH_CHUNK;
+        chunkHashes[chunk] = dmesh_fnv1a(file.data()+begin, std::min<size_t>(DMESH_HASH_CHUNK, file.size()-begin));
+    };
+
+#ifndef PARALLEL_COMPUTATION
+    //SERIAL VERSION
+    for(int chunk=0; chunk<nChunks; ++chunk)
+        hash_chunk(chunk);
+#else
+    //PARALLEL VERSION
+    solver_parallel_for(nChunks, hash_chunk, 2);
+#endif
+
+    const std::uint64_t size = file.size();
+    hash = dmesh_fnv1a(reinterpret_cast<const char*>(&size), sizeof(size));
+    hash = dmesh_fnv1a(reinterpret_cast<const char*>(chunkHashes.data()), nChunks*sizeof(std::uint64_t), hash);
+    return true;
+}
+
+
+template <typename derivedV, typename derivedF, typename derivedE, typename derivedEMAP, typename derivedTTi, typename indexType, typename cornerType>
+IGL_INLINE bool write_dmesh(const std::string& filename,
+                            const std::uint64_t& sourceHash,
+                            const Eigen::PlainObjectBase<derivedV>& V,
+                            const Eigen::PlainObjectBase<derivedF>& F,
+                            const Eigen::PlainObjectBase<derivedE>& E,
+                            const Eigen::PlainObjectBase<derivedEMAP>& edgesC,
+                            const Eigen::PlainObjectBase<derivedF>& TT,
+                            const Eigen::PlainObjectBase<derivedTTi>& TTi,
+                            const std::vector<std::vector<indexType> >& VF,
+                            const std::vector<std::vector<cornerType> >& VFi,
+                            const std::vector<bool>& isB)
+{
+    typedef typename derivedV::Scalar t_s;
+    typedef typename derivedF::Scalar t_i;
+    typedef std::int8_t t_c;
+
+    std::ofstream out(filename, std::ios::binary);
+    if(!out)
+        return false;
+
+    DMeshHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, "DMESH", 5);
+    header.version = DMESH_VERSION;
+    header.scalarBytes = sizeof(t_s);
+    header.indexBytes = sizeof(t_i);
+    header.cornerBytes = sizeof(t_c);
+    header.sourceHash = sourceHash;
+    header.nV = V.rows();
+    header.nF = F.rows();
+    header.nE = E.rows();
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    const auto write_array = [&out] (const void* data, const size_t& bytes) {
+        static const char zeros[8] = {0};
+        out.write(static_cast<const char*>(data), bytes);
+        out.write(zeros, dmesh_padded(bytes)-bytes);
+    };
+    const auto write_matrix = [&write_array] (const auto& A) {
+        typedef typename std::decay<decltype(A)>::type::Scalar t_a;
+        write_array(A.data(), A.size()*sizeof(t_a));
+    };
+
+    write_matrix(DMeshArray<t_s, 3>(V));
+    write_matrix(DMeshArray<t_i, 3>(F));
+    write_matrix(DMeshArray<t_i, 2>(E.template cast<t_i>()));
+    write_matrix(DMeshArray<t_i, 1>(edgesC.template cast<t_i>()));
+    write_matrix(DMeshArray<t_i, 3>(TT));
+    write_matrix(DMeshArray<t_c, 3>(TTi.template cast<t_c>()));
+
+    //Rings in CSR form
+    DMeshArray<t_i, 1> ringOffsets(V.rows()+1);
+    ringOffsets(0) = 0;
+    for(int v=0; v<V.rows(); ++v)
+        ringOffsets(v+1) = ringOffsets(v) + VF[v].size();
+    DMeshArray<t_i, 1> rings(ringOffsets(V.rows()));
+    DMeshArray<t_c, 1> ringCorners(ringOffsets(V.rows()));
+    for(int v=0; v<V.rows(); ++v)
+        for(int i=0; i<(int)VF[v].size(); ++i) {
+            rings(ringOffsets(v)+i) = VF[v][i];
+            ringCorners(ringOffsets(v)+i) = VFi[v][i];
+        }
+    write_matrix(ringOffsets);
+    write_matrix(rings);
+    write_matrix(ringCorners);
+
+    const std::vector<std::uint8_t> border(isB.begin(), isB.end());
+    write_array(border.data(), border.size());
+
+    return out.good();
+}
+
+
+template <typename derivedV, typename derivedF, typename derivedE, typename derivedEMAP, typename derivedTTi, typename indexType, typename cornerType>
+IGL_INLINE bool read_dmesh(const std::string& filename,
+                           const std::uint64_t& sourceHash,
+                           Eigen::PlainObjectBase<derivedV>& V,
+                           Eigen::PlainObjectBase<derivedF>& F,
+                           Eigen::PlainObjectBase<derivedE>& E,
+                           Eigen::PlainObjectBase<derivedEMAP>& edgesC,
+                           Eigen::PlainObjectBase<derivedF>& TT,
+                           Eigen::PlainObjectBase<derivedTTi>& TTi,
+                           std::vector<std::vector<indexType> >& VF,
+                           std::vector<std::vector<cornerType> >& VFi,
+                           std::vector<bool>& isB)
+{
+    typedef typename derivedV::Scalar t_s;
+    typedef typename derivedF::Scalar t_i;
+    typedef std::int8_t t_c;
+
+    MappedFile file;
+    if(!file.open(filename) || file.size() < sizeof(DMeshHeader))
+        return false;
+
+    DMeshHeader header;
+    std::memcpy(&header, file.data(), sizeof(header));
+    if(std::memcmp(header.magic, "DMESH", 5) != 0 || header.version != DMESH_VERSION || header.sourceHash != sourceHash
+       || header.scalarBytes != sizeof(t_s) || header.indexBytes != sizeof(t_i) || header.cornerBytes != sizeof(t_c))
+        return false;
+
+    //Offsets of all arrays, a truncated file is treated as stale
+    const size_t nV = header.nV, nF = header.nF, nE = header.nE;
+    const size_t sizes[] = {3*nV*sizeof(t_s), 3*nF*sizeof(t_i), 2*nE*sizeof(t_i), 3*nF*sizeof(t_i), 3*nF*sizeof(t_i), 3*nF*sizeof(t_c),
+        (nV+1)*sizeof(t_i), 3*nF*sizeof(t_i), 3*nF*sizeof(t_c), nV};
+    const int nArrays = sizeof(sizes)/sizeof(sizes[0]);
+    size_t offsets[nArrays+1];
+    offsets[0] = sizeof(DMeshHeader);
+    for(int a=0; a<nArrays; ++a)
+        offsets[a+1] = offsets[a] + dmesh_padded(sizes[a]);
+    if(file.size() < offsets[nArrays])
+        return false;
+
+    const auto array = [&file, &offsets] (const int& a) {
+        return file.data() + offsets[a];
+    };
+    typedef Eigen::Map<const DMeshArray<t_s, 3> > t_MapV;
+    typedef Eigen::Map<const DMeshArray<t_i, 3> > t_MapF;
+    typedef Eigen::Map<const DMeshArray<t_i, 2> > t_MapE;
+    typedef Eigen::Map<const DMeshArray<t_i, 1> > t_MapI;
+    typedef Eigen::Map<const DMeshArray<t_c, 3> > t_MapC;
+
+    V = t_MapV(reinterpret_cast<const t_s*>(array(0)), nV, 3);
+    F = t_MapF(reinterpret_cast<const t_i*>(array(1)), nF, 3);
+    E = t_MapE(reinterpret_cast<const t_i*>(array(2)), nE, 2).template cast<typename derivedE::Scalar>();
+    edgesC = t_MapI(reinterpret_cast<const t_i*>(array(3)), 3*nF).template cast<typename derivedEMAP::Scalar>();
+    TT = t_MapF(reinterpret_cast<const t_i*>(array(4)), nF, 3);
+    TTi = t_MapC(reinterpret_cast<const t_c*>(array(5)), nF, 3).template cast<typename derivedTTi::Scalar>();
+
+    const t_i* ringOffsets = reinterpret_cast<const t_i*>(array(6));
+    const t_i* rings = reinterpret_cast<const t_i*>(array(7));
+    const t_c* ringCorners = reinterpret_cast<const t_c*>(array(8));
+    const std::uint8_t* border = reinterpret_cast<const std::uint8_t*>(array(9));
+    VF.resize(nV);
+    VFi.resize(nV);
+    const auto copy_ring = [&] (const int& v) {
+        VF[v].assign(rings+ringOffsets[v], rings+ringOffsets[v+1]);
+        VFi[v].assign(ringCorners+ringOffsets[v], ringCorners+ringOffsets[v+1]);
+    };
+
+#ifndef PARALLEL_COMPUTATION
+    //SERIAL VERSION
+    for(int v=0; v<(int)nV; ++v)
+        copy_ring(v);
+#else
+    //PARALLEL VERSION
+    solver_parallel_for((int)nV, copy_ring);
+#endif
+
+    isB.assign(border, border+nV);
+
+    return true;
+}
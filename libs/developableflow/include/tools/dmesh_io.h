@@ -0,0 +1,94 @@
+/*
+ 
+ 2018, Oded Stein, Eitan Grinspun and Keenan Crane
+ 
+ This file is part of the code for "Developability of Triangle Meshes".
+ 
+ The code for "Developability of Triangle Meshes" is free software: you can
+ redistribute it and/or modify it under the terms of the GNU General Public
+ License as published by the Free Software Foundation, either version 2 of the
+ License, or (at your option) any later version.
+ 
+ The code for "Developability of Triangle Meshes" is distributed in the hope
+ that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with the code for "Developability of Triangle Meshes". If not,
+ see <https://www.gnu.org/licenses/>.
+ 
+ */
+
+
+#ifndef DEVELOPABLEFLOW_DMESH_IO_H
+#define DEVELOPABLEFLOW_DMESH_IO_H
+
+#include <igl/igl_inline.h>
+
+#include <Eigen/Core>
+#include <vector>
+#include <string>
+#include <cstdint>
+
+
+//Bump whenever the layout below changes, older caches are then rebuilt
+#define DMESH_VERSION 1
+//Bytes hashed by one task in dmesh_file_hash
+#define DMESH_HASH_CHUNK (1<<20)
+
+
+//Binary mesh cache (.dmesh). A fixed header followed by raw little-endian arrays, each starting at a multiple of 8 bytes,
+//so the file can be memory mapped and every array used in place:
+//  V (nV x 3 scalars, row-major), F (nF x 3), E (nE x 2), edgesC (3 nF), TT (nF x 3), TTi (nF x 3 corners),
+//  VF offsets (nV+1), VF (3 nF), VFi (3 nF corners) as CSR of the sorted rings, isB (nV bytes).
+//The header stores the hash of the file the mesh was loaded from, the cache is stale if it does not match.
+struct DMeshHeader
+{
+    char magic[8]; //"DMESH" padded with zeros
+    std::uint32_t version;
+    std::uint8_t scalarBytes, indexBytes, cornerBytes, padding;
+    std::uint64_t sourceHash;
+    std::uint64_t nV, nF, nE;
+};
+
+
+//FNV-1a of a file, hashed in chunks in parallel and then over the chunk hashes. Returns false if the file can not be read.
+IGL_INLINE bool dmesh_file_hash(const std::string& filename, //File to hash
+                                std::uint64_t& hash); //return value
+
+//Returns false if the file could not be written
+template <typename derivedV, typename derivedF, typename derivedE, typename derivedEMAP, typename derivedTTi, typename indexType, typename cornerType>
+IGL_INLINE bool write_dmesh(const std::string& filename, //.dmesh file
+                            const std::uint64_t& sourceHash, //dmesh_file_hash of the file the mesh came from
+                            const Eigen::PlainObjectBase<derivedV>& V, //Vertices
+                            const Eigen::PlainObjectBase<derivedF>& F, //Faces
+                            const Eigen::PlainObjectBase<derivedE>& E, //Edges
+                            const Eigen::PlainObjectBase<derivedEMAP>& edgesC, //EMAP
+                            const Eigen::PlainObjectBase<derivedF>& TT, //TT from triangle_triangle_adjacency
+                            const Eigen::PlainObjectBase<derivedTTi>& TTi, //TTi from triangle_triangle_adjacency
+                            const std::vector<std::vector<indexType> >& VF, //VF from vertex_triangle_adjacency
+                            const std::vector<std::vector<cornerType> >& VFi, //VFi from vertex_triangle_adjacency
+                            const std::vector<bool>& isB); //Is a vertex a bdry
+
+//Returns false if the cache is missing, of another version or type width, or stale. The outputs are then untouched.
+template <typename derivedV, typename derivedF, typename derivedE, typename derivedEMAP, typename derivedTTi, typename indexType, typename cornerType>
+IGL_INLINE bool read_dmesh(const std::string& filename, //.dmesh file
+                           const std::uint64_t& sourceHash, //dmesh_file_hash of the file the mesh should come from
+                           Eigen::PlainObjectBase<derivedV>& V, //return value, vertices
+                           Eigen::PlainObjectBase<derivedF>& F, //return value, faces
+                           Eigen::PlainObjectBase<derivedE>& E, //return value, edges
+                           Eigen::PlainObjectBase<derivedEMAP>& edgesC, //return value, EMAP
+                           Eigen::PlainObjectBase<derivedF>& TT, //return value, TT
+                           Eigen::PlainObjectBase<derivedTTi>& TTi, //return value, TTi
+                           std::vector<std::vector<indexType> >& VF, //return value, sorted VF
+                           std::vector<std::vector<cornerType> >& VFi, //return value, sorted VFi
+                           std::vector<bool>& isB); //return value, is a vertex a bdry
+
+
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "dmesh_io.cpp"
+#endif
+
+#endif
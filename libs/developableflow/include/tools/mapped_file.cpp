@@ -0,0 +1,134 @@
+/*
+ 
+ 2018, Oded Stein, Eitan Grinspun and Keenan Crane
+ 
+ This file is part of the code for "Developability of Triangle Meshes".
+ 
+ The code for "Developability of Triangle Meshes" is free software: you can
+ redistribute it and/or modify it under the terms of the GNU General Public
+ License as published by the Free Software Foundation, either version 2 of the
+ License, or (at your option) any later version.
+ 
+ The code for "Developability of Triangle Meshes" is distributed in the hope
+ that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with the code for "Developability of Triangle Meshes". If not,
+ see <https://www.gnu.org/licenses/>.
+ 
+ */
+
+
+#include "mapped_file.h"
+
+#ifdef _WIN32
+#  include <windows.h>
+#else
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <fcntl.h>
+#  include <unistd.h>
+#endif
+
+
+IGL_INLINE MappedFile::MappedFile() :
+begin(nullptr), length(0)
+#ifdef _WIN32
+, fileHandle(INVALID_HANDLE_VALUE), mappingHandle(nullptr)
+#else
+, fileDescriptor(-1)
+#endif
+{
+}
+
+
+IGL_INLINE MappedFile::~MappedFile()
+{
+    close();
+}
+
+
+IGL_INLINE bool MappedFile::open(const std::string& filename)
+{
+    close();
+    
+#ifdef _WIN32
+    fileHandle = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if(fileHandle == INVALID_HANDLE_VALUE)
+        return false;
+    LARGE_INTEGER fileSize;
+    if(!GetFileSizeEx(fileHandle, &fileSize)) {
+        close();
+        return false;
+    }
+    length = fileSize.QuadPart;
+    if(length == 0)
+        return true;
+    mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if(mappingHandle == nullptr) {
+        close();
+        return false;
+    }
+    begin = static_cast<const char*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+#else
+    fileDescriptor = ::open(filename.c_str(), O_RDONLY);
+    if(fileDescriptor < 0)
+        return false;
+    struct stat fileStat;
+    if(fstat(fileDescriptor, &fileStat) != 0) {
+        close();
+        return false;
+    }
+    length = fileStat.st_size;
+    if(length == 0)
+        return true;
+    void* mapped = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+    if(mapped != MAP_FAILED) {
+        begin = static_cast<const char*>(mapped);
+        madvise(mapped, length, MADV_SEQUENTIAL);
+    }
+#endif
+    
+    if(begin == nullptr) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+
+IGL_INLINE void MappedFile::close()
+{
+#ifdef _WIN32
+    if(begin != nullptr)
+        UnmapViewOfFile(begin);
+    if(mappingHandle != nullptr)
+        CloseHandle(mappingHandle);
+    if(fileHandle != INVALID_HANDLE_VALUE)
+        CloseHandle(fileHandle);
+    fileHandle = INVALID_HANDLE_VALUE;
+    mappingHandle = nullptr;
+#else
+    if(begin != nullptr)
+        munmap(const_cast<char*>(begin), length);
+    if(fileDescriptor >= 0)
+        ::close(fileDescriptor);
+    fileDescriptor = -1;
+#endif
+    begin = nullptr;
+    length = 0;
+}
+
+
+IGL_INLINE const char* MappedFile::data() const
+{
+    return begin;
+}
+
+
+IGL_INLINE size_t MappedFile::size() const
+{
+    return length;
+}
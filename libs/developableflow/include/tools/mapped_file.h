@@ -0,0 +1,66 @@
+/*
+ 
+ 2018, Oded Stein, Eitan Grinspun and Keenan Crane
+ 
+ This file is part of the code for "Developability of Triangle Meshes".
+ 
+ The code for "Developability of Triangle Meshes" is free software: you can
+ redistribute it and/or modify it under the terms of the GNU General Public
+ License as published by the Free Software Foundation, either version 2 of the
+ License, or (at your option) any later version.
+ 
+ The code for "Developability of Triangle Meshes" is distributed in the hope
+ that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with the code for "Developability of Triangle Meshes". If not,
+ see <https://www.gnu.org/licenses/>.
+ 
+ */
+
+
+#ifndef DEVELOPABLEFLOW_MAPPED_FILE_H
+#define DEVELOPABLEFLOW_MAPPED_FILE_H
+
+#include <igl/igl_inline.h>
+
+#include <string>
+#include <cstddef>
+
+
+//Read-only memory mapping of a whole file. The contents are not null terminated.
+class MappedFile
+{
+public:
+    IGL_INLINE MappedFile();
+    IGL_INLINE ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    //Returns true on success. An empty file maps successfully with size() 0.
+    IGL_INLINE bool open(const std::string& filename);
+    IGL_INLINE void close();
+
+    IGL_INLINE const char* data() const;
+    IGL_INLINE size_t size() const;
+
+private:
+    const char* begin;
+    size_t length;
+#ifdef _WIN32
+    void* fileHandle;
+    void* mappingHandle;
+#else
+    int fileDescriptor;
+#endif
+};
+
+
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "mapped_file.cpp"
+#endif
+
+#endif
@@ -0,0 +1,272 @@
+/*
+ 
+ 2018, Oded Stein, Eitan Grinspun and Keenan Crane
+ 
+ This file is part of the code for "Developability of Triangle Meshes".
+ 
+ The code for "Developability of Triangle Meshes" is free software: you can
+ redistribute it and/or modify it under the terms of the GNU General Public
+ License as published by the Free Software Foundation, either version 2 of the
+ License, or (at your option) any later version.
+ 
+ The code for "Developability of Triangle Meshes" is distributed in the hope
+ that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with the code for "Developability of Triangle Meshes". If not,
+ see <https://www.gnu.org/licenses/>.
+ 
+ */
+
+
+#include "mesh_writer.h"
+
+#include <charconv>
+#include <cstring>
+#include <cstdint>
+#include <algorithm>
+
+
+//Longest formatted number
+#define MESH_WRITER_NUMBER 32
+
+
+IGL_INLINE BufferedWriter::BufferedWriter(const size_t& bufferSize) :
+file(nullptr), buffer(std::max<size_t>(bufferSize, MESH_WRITER_NUMBER)), used(0), failed(false)
+{
+}
+
+
+IGL_INLINE BufferedWriter::~BufferedWriter()
+{
+    close();
+}
+
+
+IGL_INLINE bool BufferedWriter::open(const std::string& filename)
+{
+    close();
+    file = std::fopen(filename.c_str(), "wb");
+    failed = file==nullptr;
+    return !failed;
+}
+
+
+IGL_INLINE bool BufferedWriter::close()
+{
+    if(file != nullptr) {
+        flush();
+        if(std::fclose(file) != 0)
+            failed = true;
+        file = nullptr;
+    }
+    return !failed;
+}
+
+
+IGL_INLINE void BufferedWriter::flush()
+{
+    if(used > 0 && file != nullptr && std::fwrite(buffer.data(), 1, used, file) != used)
+        failed = true;
+    used = 0;
+}
+
+
+IGL_INLINE char* BufferedWriter::reserve(const size_t& bytes)
+{
+    if(used + bytes > buffer.size())
+        flush();
+    return buffer.data() + used;
+}
+
+
+IGL_INLINE void BufferedWriter::write(const void* data, const size_t& bytes)
+{
+    if(bytes > buffer.size()) {
+        flush();
+        if(file != nullptr && std::fwrite(data, 1, bytes, file) != bytes)
+            failed = true;
+        return;
+    }
+    std::memcpy(reserve(bytes), data, bytes);
+    used += bytes;
+}
+
+
+IGL_INLINE void BufferedWriter::write(const char* text)
+{
+    write(text, std::strlen(text));
+}
+
+
+IGL_INLINE void BufferedWriter::write(const std::string& text)
+{
+    write(text.data(), text.size());
+}
+
+
+IGL_INLINE void BufferedWriter::put(const char& c)
+{
+    *reserve(1) = c;
+    ++used;
+}
+
+
+IGL_INLINE void BufferedWriter::write_number(const double& x)
+{
+    char* c = reserve(MESH_WRITER_NUMBER);
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    used = std::to_chars(c, c+MESH_WRITER_NUMBER, x).ptr - buffer.data();
+#else
+    //Floating point to_chars is missing in some standard libraries
+    used += std::snprintf(c, MESH_WRITER_NUMBER, "%.17g", x);
+#endif
+}
+
+
+IGL_INLINE void BufferedWriter::write_number(const float& x)
+{
+    char* c = reserve(MESH_WRITER_NUMBER);
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    used = std::to_chars(c, c+MESH_WRITER_NUMBER, x).ptr - buffer.data();
+#else
+    used += std::snprintf(c, MESH_WRITER_NUMBER, "%.9g", x);
+#endif
+}
+
+
+IGL_INLINE void BufferedWriter::write_number(const long long& i)
+{
+    char* c = reserve(MESH_WRITER_NUMBER);
+    used = std::to_chars(c, c+MESH_WRITER_NUMBER, i).ptr - buffer.data();
+}
+
+
+IGL_INLINE void BufferedWriter::write_number(const int& i)
+{
+    write_number((long long)i);
+}
+
+
+template <typename T>
+IGL_INLINE void BufferedWriter::write_binary(const T& x)
+{
+    static const std::uint16_t one = 1;
+    char* c = reserve(sizeof(T));
+    std::memcpy(c, &x, sizeof(T));
+    if(*reinterpret_cast<const char*>(&one) == 0)
+        std::reverse(c, c+sizeof(T));
+    used += sizeof(T);
+}
+
+
+template <typename derivedV, typename derivedF>
+IGL_INLINE bool write_obj_buffered(const std::string& filename,
+                                   const Eigen::PlainObjectBase<derivedV>& V,
+                                   const Eigen::PlainObjectBase<derivedF>& F)
+{
+    Eigen::Matrix<double, Eigen::Dynamic, 2> UV;
+    Eigen::Matrix<int, Eigen::Dynamic, 3> UVF;
+    return write_obj_buffered(filename, V, F, UV, UVF);
+}
+
+
+template <typename derivedV, typename derivedF, typename derivedUV, typename derivedUVF>
+IGL_INLINE bool write_obj_buffered(const std::string& filename,
+                                   const Eigen::PlainObjectBase<derivedV>& V,
+                                   const Eigen::PlainObjectBase<derivedF>& F,
+                                   const Eigen::PlainObjectBase<derivedUV>& UV,
+                                   const Eigen::PlainObjectBase<derivedUVF>& UVF)
+{
+    BufferedWriter s;
+    if(!s.open(filename))
+        return false;
+
+    for(int v=0; v<V.rows(); ++v) {
+        s.put('v');
+        for(int j=0; j<V.cols(); ++j) {
+            s.put(' ');
+            s.write_number(double(V(v,j)));
+        }
+        s.put('\n');
+    }
+
+    const bool hasUV = UV.rows() > 0;
+    for(int v=0; v<UV.rows(); ++v) {
+        s.write("vt ", 3);
+        s.write_number(double(UV(v,0)));
+        s.put(' ');
+        s.write_number(double(UV(v,1)));
+        s.put('\n');
+    }
+
+    for(int f=0; f<F.rows(); ++f) {
+        s.put('f');
+        for(int j=0; j<F.cols(); ++j) {
+            s.put(' ');
+            s.write_number((long long)F(f,j)+1);
+            if(hasUV) {
+                s.put('/');
+                s.write_number((long long)UVF(f,j)+1);
+            }
+        }
+        s.put('\n');
+    }
+
+    return s.close();
+}
+
+
+template <typename derivedV, typename derivedF, typename derivedUV, typename derivedUVF>
+IGL_INLINE bool write_ply_binary(const std::string& filename,
+                                 const Eigen::PlainObjectBase<derivedV>& V,
+                                 const Eigen::PlainObjectBase<derivedF>& F,
+                                 const Eigen::PlainObjectBase<derivedUV>& UV,
+                                 const Eigen::PlainObjectBase<derivedUVF>& UVF)
+{
+    BufferedWriter s;
+    if(!s.open(filename))
+        return false;
+
+    const bool hasUV = UV.rows() > 0;
+    s.write("ply\nformat binary_little_endian 1.0\nelement vertex ");
+    s.write_number((long long)V.rows());
+    s.write("\nproperty double x\nproperty double y\nproperty double z\nelement face ");
+    s.write_number((long long)F.rows());
+    s.write("\nproperty list uchar int vertex_indices\n");
+    if(hasUV)
+        s.write("property list uchar float texcoord\n");
+    s.write("end_header\n");
+
+    for(int v=0; v<V.rows(); ++v)
+        for(int j=0; j<3; ++j)
+            s.write_binary(double(j<V.cols() ? V(v,j) : 0));
+
+    for(int f=0; f<F.rows(); ++f) {
+        s.write_binary(std::uint8_t(3));
+        for(int j=0; j<3; ++j)
+            s.write_binary(std::int32_t(F(f,j)));
+        if(hasUV) {
+            s.write_binary(std::uint8_t(6));
+            for(int j=0; j<3; ++j) {
+                s.write_binary(float(UV(UVF(f,j),0)));
+                s.write_binary(float(UV(UVF(f,j),1)));
+            }
+        }
+    }
+
+    return s.close();
+}
+
+
+template <typename derivedV, typename derivedF>
+IGL_INLINE bool write_ply_binary(const std::string& filename,
+                                 const Eigen::PlainObjectBase<derivedV>& V,
+                                 const Eigen::PlainObjectBase<derivedF>& F)
+{
+    Eigen::Matrix<double, Eigen::Dynamic, 2> UV;
+    Eigen::Matrix<int, Eigen::Dynamic, 3> UVF;
+    return write_ply_binary(filename, V, F, UV, UVF);
+}
@@ -0,0 +1,113 @@
+/*
+ 
+ 2018, Oded Stein, Eitan Grinspun and Keenan Crane
+ 
+ This file is part of the code for "Developability of Triangle Meshes".
+ 
+ The code for "Developability of Triangle Meshes" is free software: you can
+ redistribute it and/or modify it under the terms of the GNU General Public
+ License as published by the Free Software Foundation, either version 2 of the
+ License, or (at your option) any later version.
+ 
+ The code for "Developability of Triangle Meshes" is distributed in the hope
+ that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with the code for "Developability of Triangle Meshes". If not,
+ see <https://www.gnu.org/licenses/>.
+ 
+ */
+
+
+#ifndef DEVELOPABLEFLOW_MESH_WRITER_H
+#define DEVELOPABLEFLOW_MESH_WRITER_H
+
+#include <igl/igl_inline.h>
+
+#include <Eigen/Core>
+#include <string>
+#include <vector>
+#include <cstdio>
+
+
+//Bytes collected before they are handed to the file
+#define MESH_WRITER_BUFFER (1<<22)
+
+
+//Output file with one large buffer. Numbers are formatted with std::to_chars (shortest representation that reads back exactly),
+//nothing is flushed before the buffer is full or the file is closed.
+class BufferedWriter
+{
+public:
+    IGL_INLINE BufferedWriter(const size_t& bufferSize = MESH_WRITER_BUFFER);
+    IGL_INLINE ~BufferedWriter();
+    BufferedWriter(const BufferedWriter&) = delete;
+    BufferedWriter& operator=(const BufferedWriter&) = delete;
+
+    //Returns false if the file can not be opened
+    IGL_INLINE bool open(const std::string& filename);
+    //Returns false if anything could not be written
+    IGL_INLINE bool close();
+
+    IGL_INLINE void write(const void* data, const size_t& bytes);
+    IGL_INLINE void write(const char* text);
+    IGL_INLINE void write(const std::string& text);
+    IGL_INLINE void put(const char& c);
+    IGL_INLINE void write_number(const double& x);
+    IGL_INLINE void write_number(const float& x);
+    IGL_INLINE void write_number(const long long& i);
+    IGL_INLINE void write_number(const int& i);
+
+    //Raw little-endian value, for binary formats
+    template <typename T>
+    IGL_INLINE void write_binary(const T& x);
+
+private:
+    IGL_INLINE void flush();
+    IGL_INLINE char* reserve(const size_t& bytes);
+
+    std::FILE* file;
+    std::vector<char> buffer;
+    size_t used;
+    bool failed;
+};
+
+
+//OBJ with v and f lines, returns false on failure
+template <typename derivedV, typename derivedF>
+IGL_INLINE bool write_obj_buffered(const std::string& filename, //file to write
+                                   const Eigen::PlainObjectBase<derivedV>& V, //Vertices
+                                   const Eigen::PlainObjectBase<derivedF>& F); //Faces
+
+//OBJ with v, vt and f v/vt lines, returns false on failure
+template <typename derivedV, typename derivedF, typename derivedUV, typename derivedUVF>
+IGL_INLINE bool write_obj_buffered(const std::string& filename, //file to write
+                                   const Eigen::PlainObjectBase<derivedV>& V, //Vertices
+                                   const Eigen::PlainObjectBase<derivedF>& F, //Faces
+                                   const Eigen::PlainObjectBase<derivedUV>& UV, //Texture coordinates
+                                   const Eigen::PlainObjectBase<derivedUVF>& UVF); //Texture coordinate index of every corner, rows correspond to rows in F
+
+//Binary little-endian PLY with double vertex positions. If UV is not empty, every face also gets the texture coordinates
+//of its corners as a "texcoord" list (float u,v per corner), the way MeshLab reads wedge texture coordinates.
+//Returns false on failure.
+template <typename derivedV, typename derivedF, typename derivedUV, typename derivedUVF>
+IGL_INLINE bool write_ply_binary(const std::string& filename, //file to write
+                                 const Eigen::PlainObjectBase<derivedV>& V, //Vertices
+                                 const Eigen::PlainObjectBase<derivedF>& F, //Faces
+                                 const Eigen::PlainObjectBase<derivedUV>& UV, //Texture coordinates, empty for none
+                                 const Eigen::PlainObjectBase<derivedUVF>& UVF); //Texture coordinate index of every corner, rows correspond to rows in F
+
+template <typename derivedV, typename derivedF>
+IGL_INLINE bool write_ply_binary(const std::string& filename, //file to write
+                                 const Eigen::PlainObjectBase<derivedV>& V, //Vertices
+                                 const Eigen::PlainObjectBase<derivedF>& F); //Faces
+
+
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "mesh_writer.cpp"
+#endif
+
+#endif
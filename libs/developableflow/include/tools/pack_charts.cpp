@@ -0,0 +1,274 @@
+/*
+ 
+ 2018, Oded Stein, Eitan Grinspun and Keenan Crane
+ 
+ This file is part of the code for "Developability of Triangle Meshes".
+ 
+ The code for "Developability of Triangle Meshes" is free software: you can
+ redistribute it and/or modify it under the terms of the GNU General Public
+ License as published by the Free Software Foundation, either version 2 of the
+ License, or (at your option) any later version.
+ 
+ The code for "Developability of Triangle Meshes" is distributed in the hope
+ that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with the code for "Developability of Triangle Meshes". If not,
+ see <https://www.gnu.org/licenses/>.
+ 
+ */
+
+
+#include "pack_charts.h"
+
+#include <developableflow/flatten_charts.h>
+#include <tools/thread_pool.h>
+
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+
+template <typename derivedUV, typename derivedF, typename t_s>
+IGL_INLINE t_s pack_charts(Eigen::PlainObjectBase<derivedUV>& UV,
+                           const Eigen::PlainObjectBase<derivedF>& F,
+                           const t_s& sheetWidth,
+                           const t_s& spacing,
+                           const t_s& targetArea)
+{
+    typedef Eigen::Matrix<t_s, 2, 1> t_V2;
+    
+    const int nV = UV.rows();
+    
+    //Charts and their vertices
+    std::vector<int> faceChart;
+    const int nCharts = mesh_components(F, nV, faceChart);
+    std::vector<int> vertexChart(nV, -1);
+    for(int face=0; face<F.rows(); ++face)
+        for(int j=0; j<3; ++j)
+            vertexChart[F(face,j)] = faceChart[face];
+    std::vector<int> chartVertexOffsets(nCharts+1, 0);
+    for(int v=0; v<nV; ++v)
+        if(vertexChart[v] >= 0)
+            ++chartVertexOffsets[vertexChart[v]+1];
+    for(int chart=0; chart<nCharts; ++chart)
+        chartVertexOffsets[chart+1] += chartVertexOffsets[chart];
+    std::vector<int> chartVertices(chartVertexOffsets[nCharts]);
+    {
+        std::vector<int> fill(chartVertexOffsets.begin(), chartVertexOffsets.end()-1);
+        for(int v=0; v<nV; ++v)
+            if(vertexChart[v] >= 0)
+                chartVertices[fill[vertexChart[v]]++] = v;
+    }
+    
+    //Scale to the target area
+    if(targetArea > 0) {
+        t_s area = 0;
+        for(int face=0; face<F.rows(); ++face) {
+            const t_V2 a = (UV.row(F(face,1)) - UV.row(F(face,0))).template head<2>().transpose();
+            const t_V2 b = (UV.row(F(face,2)) - UV.row(F(face,0))).template head<2>().transpose();
+            area += 0.5*std::abs(a(0)*b(1) - a(1)*b(0));
+        }
+        if(area > 0)
+            UV.leftCols(2) *= std::sqrt(targetArea/area);
+    }
+    
+    //Convex hull of every chart (monotone chain), counterclockwise
+    std::vector<std::vector<t_V2> > hulls(nCharts);
+    const auto cross = [] (const t_V2& o, const t_V2& a, const t_V2& b) {
+        return (a(0)-o(0))*(b(1)-o(1)) - (a(1)-o(1))*(b(0)-o(0));
+    };
+    const auto build_hull = [&] (const int& chart) {
+        std::vector<t_V2> points;
+        points.reserve(chartVertexOffsets[chart+1] - chartVertexOffsets[chart]);
+        for(int i=chartVertexOffsets[chart]; i<chartVertexOffsets[chart+1]; ++i)
+            points.emplace_back(UV(chartVertices[i],0), UV(chartVertices[i],1));
+        std::sort(points.begin(), points.end(), [] (const t_V2& a, const t_V2& b) {
+            return a(0)<b(0) || (a(0)==b(0) && a(1)<b(1));
+        });
+        std::vector<t_V2>& hull = hulls[chart];
+        hull.resize(2*points.size());
+        int k = 0;
+        for(int i=0; i<(int)points.size(); ++i) {
+            while(k >= 2 && cross(hull[k-2], hull[k-1], points[i]) <= 0)
+                --k;
+            hull[k++] = points[i];
+        }
+        for(int i=(int)points.size()-2, lower=k+1; i>=0; --i) {
+            while(k >= lower && cross(hull[k-2], hull[k-1], points[i]) <= 0)
+                --k;
+            hull[k++] = points[i];
+        }
+        hull.resize(std::max(1, k-1));
+    };
+    
+    //Candidate orientations: every hull edge direction of every chart, the one with the smallest bounding box wins
+    std::vector<int> candidateOffsets(nCharts+1, 0);
+    
+#ifndef PARALLEL_COMPUTATION
+    //SERIAL VERSION
+    for(int chart=0; chart<nCharts; ++chart)
+        build_hull(chart);
+#else
+    //PARALLEL VERSION
+    solver_parallel_for(nCharts, build_hull, 2);
+#endif
+    
+    for(int chart=0; chart<nCharts; ++chart)
+        candidateOffsets[chart+1] = candidateOffsets[chart] + hulls[chart].size();
+    const int nCandidates = candidateOffsets[nCharts];
+    std::vector<int> candidateChart(nCandidates);
+    for(int chart=0; chart<nCharts; ++chart)
+        for(int i=candidateOffsets[chart]; i<candidateOffsets[chart+1]; ++i)
+            candidateChart[i] = chart;
+    std::vector<t_s> candidateAngles(nCandidates), candidateAreas(nCandidates);
+    const auto evaluate_candidate = [&] (const int& candidate) {
+        const int& chart = candidateChart[candidate];
+        const std::vector<t_V2>& hull = hulls[chart];
+        const int i = candidate - candidateOffsets[chart];
+        const t_V2 edge = hull[(i+1)%hull.size()] - hull[i];
+        const t_s angle = -std::atan2(edge(1), edge(0));
+        const t_s c = std::cos(angle), s = std::sin(angle);
+        t_s minX = std::numeric_limits<t_s>::max(), maxX = -minX, minY = minX, maxY = -minX;
+        for(const t_V2& p : hull) {
+            const t_s x = c*p(0) - s*p(1), y = s*p(0) + c*p(1);
+            minX = std::min(minX, x);
+            maxX = std::max(maxX, x);
+            minY = std::min(minY, y);
+            maxY = std::max(maxY, y);
+        }
+        candidateAngles[candidate] = angle;
+        candidateAreas[candidate] = (maxX-minX)*(maxY-minY);
+    };
+    
+#ifndef PARALLEL_COMPUTATION
+    //SERIAL VERSION
+    for(int candidate=0; candidate<nCandidates; ++candidate)
+        evaluate_candidate(candidate);
+#else
+    //PARALLEL VERSION
+    solver_parallel_for(nCandidates, evaluate_candidate, 64);
+#endif
+    
+    //Turn every chart by its best angle and move it to the origin
+    std::vector<t_V2> chartSizes(nCharts);
+    t_s packedArea = 0, minWidth = 0;
+    for(int chart=0; chart<nCharts; ++chart) {
+        t_s angle = 0, bestArea = std::numeric_limits<t_s>::max();
+        for(int i=candidateOffsets[chart]; i<candidateOffsets[chart+1]; ++i)
+            if(candidateAreas[i] < bestArea) {
+                bestArea = candidateAreas[i];
+                angle = candidateAngles[i];
+            }
+        const t_s c = std::cos(angle), s = std::sin(angle);
+        t_V2 minCorner = t_V2::Constant(std::numeric_limits<t_s>::max()), maxCorner = -minCorner;
+        for(int i=chartVertexOffsets[chart]; i<chartVertexOffsets[chart+1]; ++i) {
+            const int& v = chartVertices[i];
+            const t_s x = UV(v,0), y = UV(v,1);
+            UV(v,0) = c*x - s*y;
+            UV(v,1) = s*x + c*y;
+            minCorner = minCorner.cwiseMin(UV.row(v).template head<2>().transpose());
+            maxCorner = maxCorner.cwiseMax(UV.row(v).template head<2>().transpose());
+        }
+        for(int i=chartVertexOffsets[chart]; i<chartVertexOffsets[chart+1]; ++i) {
+            UV(chartVertices[i],0) -= minCorner(0);
+            UV(chartVertices[i],1) -= minCorner(1);
+        }
+        chartSizes[chart] = (maxCorner - minCorner).array() + spacing;
+        packedArea += chartSizes[chart](0)*chartSizes[chart](1);
+        minWidth = std::max(minWidth, chartSizes[chart].minCoeff());
+    }
+    
+    //Sheet width, every chart has to fit in at least one of its two orientations.
+    //Every chart carries one spacing on its top and right side, so the sheet is one spacing wider than the charts use.
+    const t_s width = std::max(sheetWidth>0 ? sheetWidth+spacing : std::sqrt(packedArea), minWidth);
+    
+    //Bottom-left skyline packing, longest charts first
+    struct SkylineNode {
+        t_s x, y, width;
+    };
+    std::vector<SkylineNode> skyline(1, SkylineNode{0, 0, width});
+    std::vector<int> order(nCharts);
+    for(int chart=0; chart<nCharts; ++chart)
+        order[chart] = chart;
+    std::sort(order.begin(), order.end(), [&chartSizes] (const int& a, const int& b) {
+        return chartSizes[a].maxCoeff() > chartSizes[b].maxCoeff();
+    });
+    
+    //Lowest position of a w-wide rectangle starting at skyline node i, infinite if it does not fit
+    const auto fit_at = [&skyline, &width] (const int& i, const t_s& w) {
+        if(skyline[i].x + w > width)
+            return std::numeric_limits<t_s>::infinity();
+        t_s y = 0, covered = 0;
+        for(int j=i; j<(int)skyline.size() && covered<w; ++j) {
+            y = std::max(y, skyline[j].y);
+            covered += skyline[j].width;
+        }
+        return y;
+    };
+    
+    t_s height = 0;
+    for(const int& chart : order) {
+        int bestNode = -1;
+        bool bestTurned = false;
+        t_s bestTop = std::numeric_limits<t_s>::infinity(), bestY = 0;
+        for(int turned=0; turned<2; ++turned) {
+            const t_s w = turned ? chartSizes[chart](1) : chartSizes[chart](0);
+            const t_s h = turned ? chartSizes[chart](0) : chartSizes[chart](1);
+            for(int i=0; i<(int)skyline.size(); ++i) {
+                const t_s y = fit_at(i, w);
+                if(y+h < bestTop || (y+h == bestTop && bestNode >= 0 && skyline[i].x < skyline[bestNode].x)) {
+                    bestTop = y+h;
+                    bestY = y;
+                    bestNode = i;
+                    bestTurned = turned;
+                }
+            }
+        }
+        
+        const t_s w = bestTurned ? chartSizes[chart](1) : chartSizes[chart](0);
+        const t_s x = skyline[bestNode].x;
+        
+        //Move the chart into place
+        for(int i=chartVertexOffsets[chart]; i<chartVertexOffsets[chart+1]; ++i) {
+            const int& v = chartVertices[i];
+            const t_s u = UV(v,0), t = UV(v,1);
+            if(bestTurned) {
+                UV(v,0) = x + (chartSizes[chart](1) - spacing) - t;
+                UV(v,1) = bestY + u;
+            } else {
+                UV(v,0) = x + u;
+                UV(v,1) = bestY + t;
+            }
+        }
+        height = std::max(height, bestTop - spacing);
+        
+        //Update the skyline: the new node covers [x, x+w), the nodes below it shrink or disappear
+        std::vector<SkylineNode> newSkyline;
+        newSkyline.reserve(skyline.size()+2);
+        for(const SkylineNode& node : skyline) {
+            if(node.x + node.width <= x || node.x >= x + w) {
+                newSkyline.push_back(node);
+                continue;
+            }
+            if(node.x < x)
+                newSkyline.push_back(SkylineNode{node.x, node.y, x - node.x});
+            if(node.x <= x)
+                newSkyline.push_back(SkylineNode{x, bestTop, w});
+            if(node.x + node.width > x + w)
+                newSkyline.push_back(SkylineNode{x + w, node.y, node.x + node.width - x - w});
+        }
+        skyline.clear();
+        for(const SkylineNode& node : newSkyline) {
+            if(!skyline.empty() && skyline.back().y == node.y)
+                skyline.back().width += node.width;
+            else
+                skyline.push_back(node);
+        }
+    }
+    
+    return height;
+}
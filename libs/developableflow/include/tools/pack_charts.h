@@ -0,0 +1,50 @@
+/*
+ 
+ 2018, Oded Stein, Eitan Grinspun and Keenan Crane
+ 
+ This file is part of the code for "Developability of Triangle Meshes".
+ 
+ The code for "Developability of Triangle Meshes" is free software: you can
+ redistribute it and/or modify it under the terms of the GNU General Public
+ License as published by the Free Software Foundation, either version 2 of the
+ License, or (at your option) any later version.
+ 
+ The code for "Developability of Triangle Meshes" is distributed in the hope
+ that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with the code for "Developability of Triangle Meshes". If not,
+ see <https://www.gnu.org/licenses/>.
+ 
+ */
+
+
+#ifndef DEVELOPABLEFLOW_PACK_CHARTS_H
+#define DEVELOPABLEFLOW_PACK_CHARTS_H
+
+#include <igl/igl_inline.h>
+
+#include <Eigen/Core>
+
+
+//Pack the charts (connected components) of a flattened mesh onto a sheet of fixed width, for cutting them out.
+//Every chart is first turned so that the bounding box of its convex hull has minimal area, trying all hull edge directions
+//of all charts in parallel. The charts are then placed with bottom-left skyline packing, each either as is or turned by 90 degrees.
+//UV is overwritten with the packed coordinates, with the sheet from (0,0) to (sheetWidth, returned height).
+//Returns the height of the packed sheet.
+template <typename derivedUV, typename derivedF, typename t_s>
+IGL_INLINE t_s pack_charts(Eigen::PlainObjectBase<derivedUV>& UV, //Flattened vertices, overwritten with the packed ones
+                           const Eigen::PlainObjectBase<derivedF>& F, //Flattened faces
+                           const t_s& sheetWidth, //Width of the sheet, 0 for a roughly square sheet. Widened if a chart does not fit.
+                           const t_s& spacing, //Gap between the charts
+                           const t_s& targetArea = 0); //If positive, the charts are first scaled to this total area (e.g. the area in 3D)
+
+
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "pack_charts.cpp"
+#endif
+
+#endif
@@ -0,0 +1,203 @@
+/*
+ 
+ 2018, Oded Stein, Eitan Grinspun and Keenan Crane
+ 
+ This file is part of the code for "Developability of Triangle Meshes".
+ 
+ The code for "Developability of Triangle Meshes" is free software: you can
+ redistribute it and/or modify it under the terms of the GNU General Public
+ License as published by the Free Software Foundation, either version 2 of the
+ License, or (at your option) any later version.
+ 
+ The code for "Developability of Triangle Meshes" is distributed in the hope
+ that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with the code for "Developability of Triangle Meshes". If not,
+ see <https://www.gnu.org/licenses/>.
+ 
+ */
+
+
+#include "read_obj_mapped.h"
+
+#include <tools/mapped_file.h>
+#include <tools/thread_pool.h>
+
+#include <vector>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <atomic>
+
+
+//Skip spaces and tabs
+IGL_INLINE const char* obj_skip_blanks(const char* c, const char* end)
+{
+    while(c<end && (*c==' ' || *c=='\t'))
+        ++c;
+    return c;
+}
+
+
+//Skip to the next blank or line break
+IGL_INLINE const char* obj_skip_token(const char* c, const char* end)
+{
+    while(c<end && *c!=' ' && *c!='\t' && *c!='\n' && *c!='\r')
+        ++c;
+    return c;
+}
+
+
+template <typename t_s>
+IGL_INLINE const char* obj_parse_scalar(const char* c, const char* end, t_s& value)
+{
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    double parsed = 0;
+    if(c<end && *c=='+')
+        ++c;
+    const std::from_chars_result result = std::from_chars(c, end, parsed);
+    value = parsed;
+    return result.ec==std::errc() ? result.ptr : obj_skip_token(c, end);
+#else
+    //Floating point from_chars is missing in some standard libraries, the mapping is not null terminated so strtod needs a copy
+    char buffer[64];
+    const char* tokenEnd = obj_skip_token(c, end);
+    const size_t n = std::min<size_t>(tokenEnd-c, sizeof(buffer)-1);
+    std::memcpy(buffer, c, n);
+    buffer[n] = 0;
+    value = std::strtod(buffer, nullptr);
+    return tokenEnd;
+#endif
+}
+
+
+template <typename derivedV, typename derivedF>
+IGL_INLINE bool read_obj_mapped(const std::string& filename,
+                                Eigen::PlainObjectBase<derivedV>& V,
+                                Eigen::PlainObjectBase<derivedF>& F)
+{
+    typedef typename derivedF::Scalar t_F_i;
+    
+    MappedFile file;
+    if(!file.open(filename))
+        return false;
+    const char* const begin = file.data();
+    const char* const end = begin + file.size();
+    
+    //Chunk boundaries, always right after a line break
+    std::vector<const char*> chunks(1, begin);
+    while(chunks.back() < end) {
+        const char* c = chunks.back() + std::min<size_t>(OBJ_CHUNK_SIZE, end-chunks.back());
+        c = static_cast<const char*>(std::memchr(c, '\n', end-c));
+        chunks.push_back(c==nullptr ? end : c+1);
+    }
+    const int nChunks = chunks.size()-1;
+    
+    //Calls vertex_func(line) for every vertex line and face_func(line) for every face line of a chunk
+    const auto for_lines = [&chunks, end] (const int& chunk, const auto& vertex_func, const auto& face_func) {
+        const char* c = chunks[chunk];
+        const char* const chunkEnd = chunks[chunk+1];
+        while(c < chunkEnd) {
+            const char* lineEnd = static_cast<const char*>(std::memchr(c, '\n', chunkEnd-c));
+            if(lineEnd == nullptr)
+                lineEnd = chunkEnd;
+            c = obj_skip_blanks(c, lineEnd);
+            if(lineEnd-c > 1 && (c[1]==' ' || c[1]=='\t')) {
+                if(c[0] == 'v')
+                    vertex_func(c+2, lineEnd);
+                else if(c[0] == 'f')
+                    face_func(c+2, lineEnd);
+            }
+            c = lineEnd+1;
+        }
+    };
+    
+    //Number of corners of a face line
+    const auto count_corners = [] (const char* c, const char* lineEnd) {
+        int corners = 0;
+        for(c=obj_skip_blanks(c, lineEnd); c<lineEnd && *c!='\r' && *c!='#'; c=obj_skip_blanks(obj_skip_token(c, lineEnd), lineEnd))
+            ++corners;
+        return corners;
+    };
+    
+    //First pass: vertices and triangles per chunk
+    std::vector<t_F_i> vertexOffsets(nChunks+1, 0), faceOffsets(nChunks+1, 0);
+    const auto count_chunk = [&] (const int& chunk) {
+        t_F_i nV = 0, nF = 0;
+        for_lines(chunk,
+                  [&nV] (const char*, const char*) { ++nV; },
+                  [&nF, &count_corners] (const char* c, const char* lineEnd) { nF += std::max(0, count_corners(c, lineEnd)-2); });
+        vertexOffsets[chunk+1] = nV;
+        faceOffsets[chunk+1] = nF;
+    };
+    
+#ifndef PARALLEL_COMPUTATION
+    //SERIAL VERSION
+    for(int chunk=0; chunk<nChunks; ++chunk)
+        count_chunk(chunk);
+#else
+    //PARALLEL VERSION
+    solver_parallel_for(nChunks, count_chunk, 2);
+#endif
+    
+    for(int chunk=0; chunk<nChunks; ++chunk) {
+        vertexOffsets[chunk+1] += vertexOffsets[chunk];
+        faceOffsets[chunk+1] += faceOffsets[chunk];
+    }
+    V.resize(vertexOffsets[nChunks], 3);
+    F.resize(faceOffsets[nChunks], 3);
+    
+    //Second pass: parse every chunk into its rows
+    std::atomic<bool> valid(true);
+    const auto parse_chunk = [&] (const int& chunk) {
+        t_F_i v = vertexOffsets[chunk], f = faceOffsets[chunk];
+        const auto parse_vertex = [&] (const char* c, const char* lineEnd) {
+            for(int j=0; j<3; ++j)
+                c = obj_parse_scalar(obj_skip_blanks(c, lineEnd), lineEnd, V(v,j));
+            ++v;
+        };
+        const auto parse_face = [&] (const char* c, const char* lineEnd) {
+            t_F_i first = 0, previous = 0;
+            int corner = 0;
+            for(c=obj_skip_blanks(c, lineEnd); c<lineEnd && *c!='\r' && *c!='#'; c=obj_skip_blanks(obj_skip_token(c, lineEnd), lineEnd), ++corner) {
+                long long index = 0;
+                if(*c == '+')
+                    ++c;
+                if(std::from_chars(c, lineEnd, index).ec != std::errc() || index == 0) {
+                    valid = false;
+                    index = 1;
+                }
+                //OBJ indices are 1-based, negative ones count back from the last vertex read so far
+                const t_F_i vert = index>0 ? index-1 : v+index;
+                if(corner >= 2) {
+                    F(f,0) = first;
+                    F(f,1) = previous;
+                    F(f,2) = vert;
+                    ++f;
+                } else if(corner == 0) {
+                    first = vert;
+                }
+                previous = vert;
+            }
+        };
+        for_lines(chunk, parse_vertex, parse_face);
+    };
+    
+#ifndef PARALLEL_COMPUTATION
+    //SERIAL VERSION
+    for(int chunk=0; chunk<nChunks; ++chunk)
+        parse_chunk(chunk);
+#else
+    //PARALLEL VERSION
+    solver_parallel_for(nChunks, parse_chunk, 2);
+#endif
+    
+    //Indices out of range
+    if(F.size()>0 && (F.minCoeff()<0 || F.maxCoeff()>=V.rows()))
+        valid = false;
+    
+    return valid;
+}
@@ -0,0 +1,53 @@
+/*
+ 
+ 2018, Oded Stein, Eitan Grinspun and Keenan Crane
+ 
+ This file is part of the code for "Developability of Triangle Meshes".
+ 
+ The code for "Developability of Triangle Meshes" is free software: you can
+ redistribute it and/or modify it under the terms of the GNU General Public
+ License as published by the Free Software Foundation, either version 2 of the
+ License, or (at your option) any later version.
+ 
+ The code for "Developability of Triangle Meshes" is distributed in the hope
+ that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with the code for "Developability of Triangle Meshes". If not,
+ see <https://www.gnu.org/licenses/>.
+ 
+ */
+
+
+#ifndef DEVELOPABLEFLOW_READ_OBJ_MAPPED_H
+#define DEVELOPABLEFLOW_READ_OBJ_MAPPED_H
+
+#include <igl/igl_inline.h>
+
+#include <Eigen/Core>
+#include <string>
+
+
+//Bytes of the file parsed by one task
+#define OBJ_CHUNK_SIZE (1<<20)
+
+
+//Read the vertices and faces of an OBJ file. The file is memory mapped and split into chunks at line breaks.
+//A first parallel pass counts the vertices and triangles of every chunk, a second one parses every chunk
+//straight into its rows of V and F with std::from_chars. Lines have no length limit.
+//Polygons are triangulated as fans, texture and normal indices are skipped, negative (relative) indices are supported.
+//Returns true on success.
+template <typename derivedV, typename derivedF>
+IGL_INLINE bool read_obj_mapped(const std::string& filename, //OBJ file
+                                Eigen::PlainObjectBase<derivedV>& V, //return value, vertices
+                                Eigen::PlainObjectBase<derivedF>& F); //return value, triangles
+
+
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "read_obj_mapped.cpp"
+#endif
+
+#endif
@@ -0,0 +1,234 @@
+/*
+
+ 2018, Oded Stein, Eitan Grinspun and Keenan Crane
+
+ This file is part of the code for "Developability of Triangle Meshes".
+
+ The code for "Developability of Triangle Meshes" is free software: you can
+ redistribute it and/or modify it under the terms of the GNU General Public
+ License as published by the Free Software Foundation, either version 2 of the
+ License, or (at your option) any later version.
+
+ The code for "Developability of Triangle Meshes" is distributed in the hope
+ that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with the code for "Developability of Triangle Meshes". If not,
+ see <https://www.gnu.org/licenses/>.
+
+ */
+
+
+#include "thread_pool.h"
+
+#include <atomic>
+#include <algorithm>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+
+//Each thread grabs chunks of this many grains so that uneven vertex valences still balance out
+#define CHUNKS_PER_THREAD 8
+
+
+//Set on the pool threads (and the caller) while a loop runs, nested loops then run serially
+IGL_INLINE bool& inside_parallel_loop()
+{
+    static thread_local bool inside = false;
+    return inside;
+}
+
+
+IGL_INLINE ThreadPool::ThreadPool(const unsigned int& nThreads,
+                                  const bool& pinThreads) :
+job(nullptr), generation(0), busy(0), stopping(false)
+{
+    start(nThreads, pinThreads);
+}
+
+
+IGL_INLINE ThreadPool::~ThreadPool()
+{
+    stop();
+}
+
+
+IGL_INLINE void ThreadPool::resize(const unsigned int& nThreads, const bool& pinThreads)
+{
+    std::lock_guard<std::mutex> dispatchLock(dispatchMutex);
+    stop();
+    start(nThreads, pinThreads);
+}
+
+
+IGL_INLINE unsigned int ThreadPool::size() const
+{
+    return workers.size() + 1;
+}
+
+
+IGL_INLINE void ThreadPool::start(const unsigned int& nThreads, const bool& pinThreads)
+{
+    const unsigned int nCores = std::max(1u, std::thread::hardware_concurrency());
+    const unsigned int n = nThreads==0 ? nCores : nThreads;
+
+    stopping = false;
+    workers.reserve(n-1);
+    for(unsigned int t=1; t<n; ++t) {
+        workers.emplace_back(&ThreadPool::worker_loop, this, t, generation);
+#ifdef __linux__
+        if(pinThreads) {
+            cpu_set_t cpus;
+            CPU_ZERO(&cpus);
+            CPU_SET(t % nCores, &cpus);
+            pthread_setaffinity_np(workers.back().native_handle(), sizeof(cpu_set_t), &cpus);
+        }
+#endif
+    }
+}
+
+
+IGL_INLINE void ThreadPool::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeCondition.notify_all();
+    for(std::thread& worker : workers)
+        worker.join();
+    workers.clear();
+}
+
+
+IGL_INLINE void ThreadPool::worker_loop(const unsigned int& thread, const unsigned long& startGeneration)
+{
+    unsigned long seenGeneration = startGeneration;
+    while(true) {
+        std::unique_lock<std::mutex> lock(mutex);
+        wakeCondition.wait(lock, [this, &seenGeneration] () {return stopping || generation!=seenGeneration;});
+        if(stopping)
+            return;
+        seenGeneration = generation;
+        const std::function<void(const unsigned int&)>& currentJob = *job;
+        lock.unlock();
+
+        inside_parallel_loop() = true;
+        currentJob(thread);
+        inside_parallel_loop() = false;
+
+        lock.lock();
+        if(--busy == 0)
+            doneCondition.notify_one();
+    }
+}
+
+
+IGL_INLINE void ThreadPool::run(const std::function<void(const unsigned int&)>& i_job)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = &i_job;
+        busy = workers.size();
+        ++generation;
+    }
+    wakeCondition.notify_all();
+
+    inside_parallel_loop() = true;
+    i_job(0);
+    inside_parallel_loop() = false;
+
+    std::unique_lock<std::mutex> lock(mutex);
+    doneCondition.wait(lock, [this] () {return busy==0;});
+    job = nullptr;
+}
+
+
+template <typename Index, typename PrepFunctionType, typename FunctionType, typename AccumFunctionType>
+IGL_INLINE bool ThreadPool::parallel_for(
+                                         const Index& loopSize,
+                                         const PrepFunctionType& prep_func,
+                                         const FunctionType& func,
+                                         const AccumFunctionType& accum_func,
+                                         const size_t& minGrain)
+{
+    if(loopSize <= 0)
+        return false;
+
+    //Tiny loops, single-threaded pools and loops nested inside a pool loop stay on the calling thread
+    if(workers.empty() || (size_t)loopSize < minGrain || inside_parallel_loop()) {
+        prep_func(1);
+        for(Index i=0; i<loopSize; ++i)
+            func(i, 0);
+        accum_func(0);
+        return false;
+    }
+
+    std::lock_guard<std::mutex> dispatchLock(dispatchMutex);
+    const unsigned int nThreads = size();
+    const Index chunkSize = std::max<Index>(1, loopSize / (Index)(nThreads*CHUNKS_PER_THREAD));
+    std::atomic<Index> nextChunk(0);
+
+    prep_func(nThreads);
+    const std::function<void(const unsigned int&)> job = [&] (const unsigned int& thread) {
+        while(true) {
+            const Index begin = nextChunk.fetch_add(chunkSize);
+            if(begin >= loopSize)
+                break;
+            const Index end = std::min<Index>(begin+chunkSize, loopSize);
+            for(Index i=begin; i<end; ++i)
+                func(i, (size_t)thread);
+        }
+    };
+    run(job);
+    for(unsigned int t=0; t<nThreads; ++t)
+        accum_func(t);
+
+    return true;
+}
+
+
+template <typename Index, typename FunctionType>
+IGL_INLINE bool ThreadPool::parallel_for(
+                                         const Index& loopSize,
+                                         const FunctionType& func,
+                                         const size_t& minGrain)
+{
+    const auto no_op = [] (const size_t&) {};
+    const auto wrapper = [&func] (const Index& i, const size_t&) {func(i);};
+    return parallel_for(loopSize, no_op, wrapper, no_op, minGrain);
+}
+
+
+IGL_INLINE ThreadPool& solver_thread_pool()
+{
+    static ThreadPool pool;
+    return pool;
+}
+
+
+template <typename Index, typename PrepFunctionType, typename FunctionType, typename AccumFunctionType>
+IGL_INLINE bool solver_parallel_for(
+                                    const Index& loopSize,
+                                    const PrepFunctionType& prep_func,
+                                    const FunctionType& func,
+                                    const AccumFunctionType& accum_func,
+                                    const size_t& minGrain)
+{
+    return solver_thread_pool().parallel_for(loopSize, prep_func, func, accum_func, minGrain);
+}
+
+
+template <typename Index, typename FunctionType>
+IGL_INLINE bool solver_parallel_for(
+                                    const Index& loopSize,
+                                    const FunctionType& func,
+                                    const size_t& minGrain)
+{
+    return solver_thread_pool().parallel_for(loopSize, func, minGrain);
+}
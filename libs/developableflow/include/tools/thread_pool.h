@@ -0,0 +1,113 @@
+/*
+
+ 2018, Oded Stein, Eitan Grinspun and Keenan Crane
+
+ This file is part of the code for "Developability of Triangle Meshes".
+
+ The code for "Developability of Triangle Meshes" is free software: you can
+ redistribute it and/or modify it under the terms of the GNU General Public
+ License as published by the Free Software Foundation, either version 2 of the
+ License, or (at your option) any later version.
+
+ The code for "Developability of Triangle Meshes" is distributed in the hope
+ that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with the code for "Developability of Triangle Meshes". If not,
+ see <https://www.gnu.org/licenses/>.
+
+ */
+
+
+#ifndef DEVELOPABLEFLOW_THREAD_POOL_H
+#define DEVELOPABLEFLOW_THREAD_POOL_H
+
+#include <igl/igl_inline.h>
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+
+//Loops shorter than this run serially on the calling thread
+#define PARALLEL_MIN_GRAIN 256
+
+
+//Persistent pool of worker threads. The calling thread takes part in every loop as thread 0,
+//so a pool of size n owns n-1 workers that sleep between loops.
+class ThreadPool
+{
+public:
+    IGL_INLINE ThreadPool(const unsigned int& nThreads = 0, //Number of threads including the caller, 0 means hardware_concurrency
+                          const bool& pinThreads = false); //Pin each worker to one core (Linux only)
+    IGL_INLINE ~ThreadPool();
+
+    //Stop the current workers and start nThreads new ones. Must not be called from inside a loop.
+    IGL_INLINE void resize(const unsigned int& nThreads, const bool& pinThreads = false);
+
+    //Number of threads taking part in a loop, including the caller
+    IGL_INLINE unsigned int size() const;
+
+    //Same semantics as igl::parallel_for: prep_func(nThreads), then func(i, thread) for all i, then accum_func(thread) for every thread in order.
+    //Returns true if the loop ran in parallel.
+    template <typename Index, typename PrepFunctionType, typename FunctionType, typename AccumFunctionType>
+    IGL_INLINE bool parallel_for(
+                                 const Index& loopSize, //Number of iterations
+                                 const PrepFunctionType& prep_func, //Called once with the number of threads
+                                 const FunctionType& func, //Loop body func(i, thread)
+                                 const AccumFunctionType& accum_func, //Called once per thread after the loop
+                                 const size_t& minGrain = PARALLEL_MIN_GRAIN); //Loops shorter than this run serially
+
+    //Loop body func(i) only
+    template <typename Index, typename FunctionType>
+    IGL_INLINE bool parallel_for(
+                                 const Index& loopSize, //Number of iterations
+                                 const FunctionType& func, //Loop body func(i)
+                                 const size_t& minGrain = PARALLEL_MIN_GRAIN); //Loops shorter than this run serially
+
+private:
+    IGL_INLINE void start(const unsigned int& nThreads, const bool& pinThreads);
+    IGL_INLINE void stop();
+    IGL_INLINE void worker_loop(const unsigned int& thread, const unsigned long& startGeneration);
+    IGL_INLINE void run(const std::function<void(const unsigned int&)>& job);
+
+    std::vector<std::thread> workers;
+    std::mutex dispatchMutex; //Serializes loops started from different outside threads
+    std::mutex mutex;
+    std::condition_variable wakeCondition, doneCondition;
+    const std::function<void(const unsigned int&)>* job;
+    unsigned long generation;
+    unsigned int busy;
+    bool stopping;
+};
+
+
+//The pool shared by all parallel loops of the solver
+IGL_INLINE ThreadPool& solver_thread_pool();
+
+//Dispatch to solver_thread_pool(), drop-in replacements for igl::parallel_for
+template <typename Index, typename PrepFunctionType, typename FunctionType, typename AccumFunctionType>
+IGL_INLINE bool solver_parallel_for(
+                                    const Index& loopSize,
+                                    const PrepFunctionType& prep_func,
+                                    const FunctionType& func,
+                                    const AccumFunctionType& accum_func,
+                                    const size_t& minGrain = PARALLEL_MIN_GRAIN);
+
+template <typename Index, typename FunctionType>
+IGL_INLINE bool solver_parallel_for(
+                                    const Index& loopSize,
+                                    const FunctionType& func,
+                                    const size_t& minGrain = PARALLEL_MIN_GRAIN);
+
+
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "thread_pool.cpp"
+#endif
+
+#endif
@@ -0,0 +1,432 @@
+/*
+ 
+ 2018, Oded Stein, Eitan Grinspun and Keenan Crane
+ 
+ This file is part of the code for "Developability of Triangle Meshes".
+ 
+ The code for "Developability of Triangle Meshes" is free software: you can
+ redistribute it and/or modify it under the terms of the GNU General Public
+ License as published by the Free Software Foundation, either version 2 of the
+ License, or (at your option) any later version.
+ 
+ The code for "Developability of Triangle Meshes" is distributed in the hope
+ that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with the code for "Developability of Triangle Meshes". If not,
+ see <https://www.gnu.org/licenses/>.
+ 
+ */
+
+
+#include "trajectory.h"
+
+#include <tools/thread_pool.h>
+
+#include <zlib.h>
+
+#include <cstring>
+#include <cmath>
+#include <utility>
+
+
+#define TRAJECTORY_MAGIC "DTRAJ"
+#define TRAJECTORY_END_MAGIC "DTRAJEND"
+#define TRAJECTORY_VERSION 1
+#define TRAJECTORY_HEADER_BYTES 16
+#define TRAJECTORY_RECORD_HEADER_BYTES 17 //type, raw size, compressed size
+#define TRAJECTORY_FOOTER_BYTES 24 //number of steps, index offset, end magic
+
+
+IGL_INLINE void trajectory_put_varint(std::vector<char>& raw, const std::int64_t& value)
+{
+    std::uint64_t zigzag = (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+    while(zigzag >= 0x80) {
+        raw.push_back(static_cast<char>(zigzag | 0x80));
+        zigzag >>= 7;
+    }
+    raw.push_back(static_cast<char>(zigzag));
+}
+
+
+//Returns false if the varint runs past end
+IGL_INLINE bool trajectory_get_varint(const char*& c, const char* end, std::int64_t& value)
+{
+    std::uint64_t zigzag = 0;
+    for(int shift=0; c<end && shift<64; shift+=7) {
+        const std::uint8_t byte = static_cast<std::uint8_t>(*c++);
+        zigzag |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+        if(byte < 0x80) {
+            value = static_cast<std::int64_t>(zigzag >> 1) ^ -static_cast<std::int64_t>(zigzag & 1);
+            return true;
+        }
+    }
+    return false;
+}
+
+
+template <typename T>
+IGL_INLINE void trajectory_put(std::vector<char>& raw, const T& value)
+{
+    const char* bytes = reinterpret_cast<const char*>(&value);
+    raw.insert(raw.end(), bytes, bytes+sizeof(T));
+}
+
+
+template <typename T>
+IGL_INLINE T trajectory_get(const char* c)
+{
+    T value;
+    std::memcpy(&value, c, sizeof(T));
+    return value;
+}
+
+
+
+IGL_INLINE TrajectoryRecorder::TrajectoryRecorder() :
+queuedBytes(0), stopping(false), failed(false), relativeQuantum(TRAJECTORY_QUANTUM), quantum(0), keyframeInterval(TRAJECTORY_KEYFRAME_INTERVAL),
+nSteps(0), lastKeyframe(0), nV(0), connectivityOffset(0), writerKeyframe(0), writerSteps(0)
+{
+}
+
+
+IGL_INLINE TrajectoryRecorder::~TrajectoryRecorder()
+{
+    close();
+}
+
+
+IGL_INLINE bool TrajectoryRecorder::open(const std::string& filename, const double& iRelativeQuantum, const int& iKeyframeInterval)
+{
+    close();
+
+    out.open(filename, std::ios::binary | std::ios::trunc);
+    if(!out)
+        return false;
+
+    relativeQuantum = iRelativeQuantum;
+    keyframeInterval = std::max(1, iKeyframeInterval);
+    queuedBytes = 0;
+    stopping = false;
+    failed = false;
+    nSteps = 0;
+    lastKeyframe = 0;
+    nV = 0;
+    lastQuantized.clear();
+    index.clear();
+    connectivityOffset = 0;
+    writerKeyframe = 0;
+    writerSteps = 0;
+
+    char header[TRAJECTORY_HEADER_BYTES] = {0};
+    std::memcpy(header, TRAJECTORY_MAGIC, 5);
+    const std::uint32_t version = TRAJECTORY_VERSION;
+    std::memcpy(header+8, &version, sizeof(version));
+    out.write(header, TRAJECTORY_HEADER_BYTES);
+
+    writer = std::thread(&TrajectoryRecorder::writer_loop, this);
+    return true;
+}
+
+
+template <typename derivedV, typename derivedF>
+IGL_INLINE void TrajectoryRecorder::record(const Eigen::PlainObjectBase<derivedV>& V,
+                                           const Eigen::PlainObjectBase<derivedF>& F,
+                                           const bool& connectivityChanged)
+{
+    if(!writer.joinable())
+        return;
+
+    if(nSteps==0 || connectivityChanged) {
+        Job job;
+        job.type = CONNECTIVITY;
+        job.quantum = 0;
+        job.values.resize(3*F.rows());
+        for(int f=0; f<F.rows(); ++f)
+            for(int j=0; j<3; ++j)
+                job.values[3*f+j] = F(f,j);
+        push(std::move(job));
+    }
+
+    //New keyframe after a change and every keyframeInterval steps
+    const bool keyframe = nSteps==0 || connectivityChanged || (std::uint64_t)V.rows()!=nV || nSteps-lastKeyframe >= (std::uint64_t)keyframeInterval;
+    if(keyframe) {
+        const double diagonal = V.rows()>0 ? (V.colwise().maxCoeff()-V.colwise().minCoeff()).norm() : 0;
+        quantum = relativeQuantum*(diagonal>0 ? diagonal : 1);
+        lastKeyframe = nSteps;
+        nV = V.rows();
+    }
+
+    Job job;
+    job.type = keyframe ? KEYFRAME : DELTA;
+    job.quantum = quantum;
+    job.values.resize(3*nV);
+    lastQuantized.resize(3*nV);
+    const auto quantize_vertex = [&] (const int& v) {
+        for(int j=0; j<3; ++j) {
+            const std::int64_t q = std::llround(V(v,j)/quantum);
+            job.values[3*v+j] = keyframe ? q : q-lastQuantized[3*v+j];
+            lastQuantized[3*v+j] = q;
+        }
+    };
+
+#ifndef PARALLEL_COMPUTATION
+    //SERIAL VERSION
+    for(int v=0; v<(int)nV; ++v)
+        quantize_vertex(v);
+#else
+    //PARALLEL VERSION
+    solver_parallel_for((int)nV, quantize_vertex);
+#endif
+
+    push(std::move(job));
+    ++nSteps;
+}
+
+
+IGL_INLINE void TrajectoryRecorder::push(Job&& job)
+{
+    const size_t bytes = sizeof(std::int64_t)*job.values.size();
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        //A job larger than the whole budget is let through once the queue is empty
+        doneCondition.wait(lock, [this, &bytes] { return queuedBytes==0 || queuedBytes+bytes <= TRAJECTORY_QUEUE_BUDGET; });
+        jobs.push_back(std::move(job));
+        queuedBytes += bytes;
+    }
+    wakeCondition.notify_one();
+}
+
+
+IGL_INLINE void TrajectoryRecorder::writer_loop()
+{
+    while(true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeCondition.wait(lock, [this] { return stopping || !jobs.empty(); });
+            if(jobs.empty())
+                return;
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+        write_record(job);
+
+        const size_t bytes = sizeof(std::int64_t)*job.values.size();
+        //Drop the values before the budget is given back
+        std::vector<std::int64_t>().swap(job.values);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            queuedBytes -= bytes;
+        }
+        doneCondition.notify_all();
+    }
+}
+
+
+IGL_INLINE void TrajectoryRecorder::write_record(const Job& job)
+{
+    //Encode
+    std::vector<char> raw;
+    if(job.type == CONNECTIVITY) {
+        trajectory_put(raw, static_cast<std::uint64_t>(job.values.size()/3));
+        raw.reserve(sizeof(std::uint64_t) + sizeof(std::int32_t)*job.values.size());
+        for(const std::int64_t& i : job.values)
+            trajectory_put(raw, static_cast<std::int32_t>(i));
+    } else {
+        raw.reserve(sizeof(double) + sizeof(std::uint64_t) + 2*job.values.size());
+        if(job.type == KEYFRAME) {
+            trajectory_put(raw, job.quantum);
+            trajectory_put(raw, static_cast<std::uint64_t>(job.values.size()/3));
+        }
+        for(const std::int64_t& q : job.values)
+            trajectory_put_varint(raw, q);
+    }
+
+    //Compress
+    uLongf compressedSize = compressBound(raw.size());
+    std::vector<Bytef> compressed(compressedSize);
+    if(compress2(compressed.data(), &compressedSize, reinterpret_cast<const Bytef*>(raw.data()), raw.size(), TRAJECTORY_COMPRESSION) != Z_OK) {
+        failed = true;
+        return;
+    }
+
+    //Write
+    const std::uint64_t offset = out.tellp();
+    const std::uint8_t type = job.type;
+    const std::uint64_t rawSize = raw.size(), storedSize = compressedSize;
+    out.write(reinterpret_cast<const char*>(&type), sizeof(type));
+    out.write(reinterpret_cast<const char*>(&rawSize), sizeof(rawSize));
+    out.write(reinterpret_cast<const char*>(&storedSize), sizeof(storedSize));
+    out.write(reinterpret_cast<const char*>(compressed.data()), compressedSize);
+
+    if(job.type == CONNECTIVITY) {
+        connectivityOffset = offset;
+    } else {
+        if(job.type == KEYFRAME)
+            writerKeyframe = writerSteps;
+        index.push_back(TrajectoryIndexEntry{offset, writerKeyframe, connectivityOffset});
+        ++writerSteps;
+    }
+}
+
+
+IGL_INLINE bool TrajectoryRecorder::close()
+{
+    if(!writer.joinable())
+        return !failed;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeCondition.notify_one();
+    writer.join();
+
+    //Index and footer
+    const std::uint64_t indexOffset = out.tellp();
+    const std::uint64_t nEntries = index.size();
+    out.write(reinterpret_cast<const char*>(index.data()), nEntries*sizeof(TrajectoryIndexEntry));
+    out.write(reinterpret_cast<const char*>(&nEntries), sizeof(nEntries));
+    out.write(reinterpret_cast<const char*>(&indexOffset), sizeof(indexOffset));
+    out.write(TRAJECTORY_END_MAGIC, 8);
+    out.close();
+    if(!out)
+        failed = true;
+
+    return !failed;
+}
+
+
+IGL_INLINE std::uint64_t TrajectoryRecorder::steps() const
+{
+    return nSteps;
+}
+
+
+
+IGL_INLINE TrajectoryReader::TrajectoryReader() :
+quantum(0), currentStep(-1), facesOffset(0)
+{
+}
+
+
+IGL_INLINE bool TrajectoryReader::open(const std::string& filename)
+{
+    index.clear();
+    quantized.clear();
+    faces.clear();
+    currentStep = -1;
+    facesOffset = 0;
+
+    if(!file.open(filename) || file.size() < TRAJECTORY_HEADER_BYTES+TRAJECTORY_FOOTER_BYTES)
+        return false;
+    const char* data = file.data();
+    const char* footer = data + file.size() - TRAJECTORY_FOOTER_BYTES;
+    if(std::memcmp(data, TRAJECTORY_MAGIC, 5) != 0 || trajectory_get<std::uint32_t>(data+8) != TRAJECTORY_VERSION
+       || std::memcmp(footer+16, TRAJECTORY_END_MAGIC, 8) != 0)
+        return false;
+
+    const std::uint64_t nEntries = trajectory_get<std::uint64_t>(footer);
+    const std::uint64_t indexOffset = trajectory_get<std::uint64_t>(footer+8);
+    if(indexOffset + nEntries*sizeof(TrajectoryIndexEntry) != file.size()-TRAJECTORY_FOOTER_BYTES)
+        return false;
+    index.resize(nEntries);
+    std::memcpy(index.data(), data+indexOffset, nEntries*sizeof(TrajectoryIndexEntry));
+    return true;
+}
+
+
+IGL_INLINE std::uint64_t TrajectoryReader::steps() const
+{
+    return index.size();
+}
+
+
+IGL_INLINE bool TrajectoryReader::decode_record(const std::uint64_t& offset, std::uint8_t& type, std::vector<char>& raw) const
+{
+    if(offset + TRAJECTORY_RECORD_HEADER_BYTES > file.size())
+        return false;
+    const char* c = file.data() + offset;
+    type = static_cast<std::uint8_t>(c[0]);
+    const std::uint64_t rawSize = trajectory_get<std::uint64_t>(c+1);
+    const std::uint64_t storedSize = trajectory_get<std::uint64_t>(c+9);
+    if(offset + TRAJECTORY_RECORD_HEADER_BYTES + storedSize > file.size())
+        return false;
+    raw.resize(rawSize);
+    uLongf size = rawSize;
+    return uncompress(reinterpret_cast<Bytef*>(raw.data()), &size, reinterpret_cast<const Bytef*>(c+TRAJECTORY_RECORD_HEADER_BYTES), storedSize) == Z_OK
+    && size == rawSize;
+}
+
+
+template <typename derivedV, typename derivedF>
+IGL_INLINE bool TrajectoryReader::read(const std::uint64_t& step,
+                                       Eigen::PlainObjectBase<derivedV>& V,
+                                       Eigen::PlainObjectBase<derivedF>& F)
+{
+    if(step >= index.size())
+        return false;
+    const TrajectoryIndexEntry& entry = index[step];
+    std::uint8_t type;
+
+    //Start over from the keyframe unless we can keep stepping forward from the last read step
+    if(currentStep < 0 || (std::uint64_t)currentStep > step || index[currentStep].keyframeStep != entry.keyframeStep) {
+        currentStep = -1;
+        if(!decode_record(index[entry.keyframeStep].frameOffset, type, raw) || type != 2 || raw.size() < sizeof(double)+sizeof(std::uint64_t))
+            return false;
+        quantum = trajectory_get<double>(raw.data());
+        const std::uint64_t nV = trajectory_get<std::uint64_t>(raw.data()+sizeof(double));
+        quantized.resize(3*nV);
+        const char* c = raw.data() + sizeof(double) + sizeof(std::uint64_t);
+        for(std::int64_t& q : quantized)
+            if(!trajectory_get_varint(c, raw.data()+raw.size(), q))
+                return false;
+        currentStep = entry.keyframeStep;
+    }
+
+    //Deltas up to step
+    for(std::uint64_t s=currentStep+1; s<=step; ++s) {
+        if(!decode_record(index[s].frameOffset, type, raw) || type != 3) {
+            currentStep = -1;
+            return false;
+        }
+        const char* c = raw.data();
+        for(std::int64_t& q : quantized) {
+            std::int64_t delta;
+            if(!trajectory_get_varint(c, raw.data()+raw.size(), delta)) {
+                currentStep = -1;
+                return false;
+            }
+            q += delta;
+        }
+        currentStep = s;
+    }
+
+    //Faces, decoded again only if the connectivity changed
+    if(faces.empty() || facesOffset != entry.connectivityOffset) {
+        faces.clear();
+        if(!decode_record(entry.connectivityOffset, type, raw) || type != 1 || raw.size() < sizeof(std::uint64_t))
+            return false;
+        const std::uint64_t nF = trajectory_get<std::uint64_t>(raw.data());
+        if(raw.size() != sizeof(std::uint64_t) + 3*nF*sizeof(std::int32_t))
+            return false;
+        faces.resize(3*nF);
+        std::memcpy(faces.data(), raw.data()+sizeof(std::uint64_t), 3*nF*sizeof(std::int32_t));
+        facesOffset = entry.connectivityOffset;
+    }
+
+    const int nV = quantized.size()/3;
+    V.resize(nV, 3);
+    for(int v=0; v<nV; ++v)
+        for(int j=0; j<3; ++j)
+            V(v,j) = quantum*quantized[3*v+j];
+    F.resize(faces.size()/3, 3);
+    for(int f=0; f<F.rows(); ++f)
+        for(int j=0; j<3; ++j)
+            F(f,j) = faces[3*f+j];
+
+    return true;
+}
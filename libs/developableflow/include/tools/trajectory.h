@@ -0,0 +1,163 @@
+/*
+ 
+ 2018, Oded Stein, Eitan Grinspun and Keenan Crane
+ 
+ This file is part of the code for "Developability of Triangle Meshes".
+ 
+ The code for "Developability of Triangle Meshes" is free software: you can
+ redistribute it and/or modify it under the terms of the GNU General Public
+ License as published by the Free Software Foundation, either version 2 of the
+ License, or (at your option) any later version.
+ 
+ The code for "Developability of Triangle Meshes" is distributed in the hope
+ that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with the code for "Developability of Triangle Meshes". If not,
+ see <https://www.gnu.org/licenses/>.
+ 
+ */
+
+
+#ifndef DEVELOPABLEFLOW_TRAJECTORY_H
+#define DEVELOPABLEFLOW_TRAJECTORY_H
+
+#include <igl/igl_inline.h>
+
+#include <tools/mapped_file.h>
+
+#include <Eigen/Core>
+#include <vector>
+#include <deque>
+#include <string>
+#include <cstdint>
+#include <fstream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+
+//Quantization step of the vertex positions, relative to the bounding box diagonal of the keyframe
+#define TRAJECTORY_QUANTUM 1e-6
+//A full frame is stored every this many steps, so a random step never needs more deltas than this
+#define TRAJECTORY_KEYFRAME_INTERVAL 64
+//zlib level, 1 is the fastest
+#define TRAJECTORY_COMPRESSION 1
+//Bytes of steps that may wait for the writer before record() waits for it
+#define TRAJECTORY_QUEUE_BUDGET (size_t(256)<<20)
+
+
+//Trajectory file (.dtraj): a header, then one zlib-compressed record per connectivity change and per step, then an index.
+//  connectivity record: nF, F as int32
+//  keyframe record: quantum, nV, all quantized coordinates as zigzag varints
+//  delta record: quantized coordinates minus those of the previous step as zigzag varints
+//Keyframes are written every TRAJECTORY_KEYFRAME_INTERVAL steps and after every connectivity change.
+//The positions are quantized before the deltas are taken, so playback does not drift, the error is at most half a quantum.
+//Records are little endian.
+struct TrajectoryIndexEntry
+{
+    std::uint64_t frameOffset; //record of this step
+    std::uint64_t keyframeStep; //step of the keyframe the deltas start from
+    std::uint64_t connectivityOffset; //record of the faces of this step
+};
+
+
+//Records the flow step by step. Quantization happens on the calling thread,
+//encoding, compression and writing on a background thread. If the writer falls behind by more than
+//TRAJECTORY_QUEUE_BUDGET bytes of queued steps, record() blocks until it has caught up.
+class TrajectoryRecorder
+{
+public:
+    IGL_INLINE TrajectoryRecorder();
+    IGL_INLINE ~TrajectoryRecorder();
+
+    //Returns false if the file can not be opened
+    IGL_INLINE bool open(const std::string& filename, //.dtraj file
+                         const double& relativeQuantum = TRAJECTORY_QUANTUM, //Quantization step relative to the bounding box diagonal
+                         const int& keyframeInterval = TRAJECTORY_KEYFRAME_INTERVAL); //Steps between keyframes
+
+    //Record one step, e.g. after every timestep. The faces are only stored on the first step and when connectivityChanged is set,
+    //which is what mesh_postprocessing returns as 1.
+    template <typename derivedV, typename derivedF>
+    IGL_INLINE void record(const Eigen::PlainObjectBase<derivedV>& V, //Vertices
+                           const Eigen::PlainObjectBase<derivedF>& F, //Faces
+                           const bool& connectivityChanged = false); //Did F change since the last step
+
+    //Wait for the writer, write the index. Returns false if anything could not be written.
+    IGL_INLINE bool close();
+
+    //Number of recorded steps
+    IGL_INLINE std::uint64_t steps() const;
+
+private:
+    enum RecordType : std::uint8_t {CONNECTIVITY = 1, KEYFRAME = 2, DELTA = 3};
+    struct Job {
+        RecordType type;
+        double quantum;
+        std::vector<std::int64_t> values;
+    };
+
+    IGL_INLINE void push(Job&& job);
+    IGL_INLINE void writer_loop();
+    IGL_INLINE void write_record(const Job& job);
+
+    std::ofstream out;
+    std::thread writer;
+    std::mutex mutex;
+    std::condition_variable wakeCondition, doneCondition;
+    std::deque<Job> jobs;
+    size_t queuedBytes;
+    bool stopping, failed;
+
+    double relativeQuantum, quantum;
+    int keyframeInterval;
+    std::uint64_t nSteps, lastKeyframe, nV;
+    std::vector<std::int64_t> lastQuantized;
+
+    //Owned by the writer thread
+    std::vector<TrajectoryIndexEntry> index;
+    std::uint64_t connectivityOffset, writerKeyframe, writerSteps;
+};
+
+
+//Random access playback of a .dtraj file
+class TrajectoryReader
+{
+public:
+    IGL_INLINE TrajectoryReader();
+
+    //Returns false if the file is not a complete trajectory
+    IGL_INLINE bool open(const std::string& filename);
+
+    //Number of recorded steps
+    IGL_INLINE std::uint64_t steps() const;
+
+    //Vertices and faces at a step. Stepping forward from the last read step within the same keyframe
+    //only decodes the new deltas. Returns false if the step does not exist or the file is damaged.
+    template <typename derivedV, typename derivedF>
+    IGL_INLINE bool read(const std::uint64_t& step, //Step to read, 0-based
+                         Eigen::PlainObjectBase<derivedV>& V, //return value, vertices
+                         Eigen::PlainObjectBase<derivedF>& F); //return value, faces
+
+private:
+    IGL_INLINE bool decode_record(const std::uint64_t& offset, std::uint8_t& type, std::vector<char>& raw) const;
+
+    MappedFile file;
+    std::vector<TrajectoryIndexEntry> index;
+    std::vector<char> raw;
+    std::vector<std::int64_t> quantized;
+    double quantum;
+    std::int64_t currentStep; //step quantized holds, -1 for none
+    std::vector<std::int32_t> faces;
+    std::uint64_t facesOffset; //connectivity record faces was decoded from
+};
+
+
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "trajectory.cpp"
+#endif
+
+#endif
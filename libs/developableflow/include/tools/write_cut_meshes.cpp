@@ -23,12 +23,13 @@
 
 #include "write_cut_meshes.h"
 
-#include <iostream>
-#include <igl/writeOBJ.h>
+#include <tools/mesh_writer.h>
+
+#include <string>
 
 
 template <typename derivedV, typename derivedF, typename derivedFlatV, typename derivedFlatF>
-IGL_INLINE void write_cut_meshes(
+IGL_INLINE bool write_cut_meshes(
                                  const Eigen::PlainObjectBase<derivedV>& V,
                                  const Eigen::PlainObjectBase<derivedF>& F,
                                  const Eigen::PlainObjectBase<derivedFlatV>& flatV,
@@ -38,15 +39,15 @@ IGL_INLINE void write_cut_meshes(
                                  const std::vector<std::pair<int,int> >& protocol,
                                  const int& maxTime)
 {
-    Eigen::PlainObjectBase<derivedV> dummyV;
-    Eigen::PlainObjectBase<derivedF> dummyF;
-    write_cut_meshes(V, F, flatV, flatF, dummyV, dummyF, filename1, filename2, protocol, maxTime);
+    derivedV dummyV;
+    derivedF dummyF;
+    return write_cut_meshes(V, F, flatV, flatF, dummyV, dummyF, filename1, filename2, protocol, maxTime);
 }
 
 
 
 template <typename derivedV, typename derivedF, typename derivedFlatV, typename derivedFlatF, typename derivedOrigV, typename derivedOrigF>
-IGL_INLINE void write_cut_meshes(
+IGL_INLINE bool write_cut_meshes(
                                  const Eigen::PlainObjectBase<derivedV>& V,
                                  const Eigen::PlainObjectBase<derivedF>& F,
                                  const Eigen::PlainObjectBase<derivedFlatV>& flatV,
@@ -59,40 +60,86 @@ IGL_INLINE void write_cut_meshes(
                                  const int& maxTime)
 {
     
+    //.ply files are written as binary PLY, everything else as OBJ
+    const auto is_ply = [] (const std::string& filename) {
+        return filename.size()>=4 && filename.compare(filename.size()-4, 4, ".ply")==0;
+    };
+    
     //Write cut as mesh
-    if(!filename1.empty())
-        igl::writeOBJ(filename1, flatV, flatF);
+    bool success = true;
+    if(!filename1.empty()) {
+        if(is_ply(filename1))
+            success = write_ply_binary(filename1, flatV, flatF);
+        else
+            success = write_obj_buffered(filename1, flatV, flatF);
+    }
     
     //Write cut as old mesh plus texture coords
     if(!filename2.empty()) {
         assert(F.rows() == flatF.rows() && "The flattened mesh and the original mesh must have the same number of faces");
         
-        std::ofstream s(filename2);
-        s.precision(17);
+        //PLY has no place for the protocol and the original mesh, only the mesh with its texture coords is written
+        if(is_ply(filename2))
+            return write_ply_binary(filename2, V, F, flatV, flatF) && success;
+        
+        BufferedWriter s;
+        if(!s.open(filename2))
+            return false;
         
-        s << "# Protocol of actions (translations of numbers to keys: http://www.glfw.org/docs/latest/group__keys.html)" << std::endl;
-        for(int p=0; p<protocol.size(); ++p)
-            s << "#" << protocol[p].first << " " << protocol[p].second << std::endl;
+        s.write("# Protocol of actions (translations of numbers to keys: http://www.glfw.org/docs/latest/group__keys.html)\n");
+        for(int p=0; p<(int)protocol.size(); ++p) {
+            s.put('#');
+            s.write_number(protocol[p].first);
+            s.put(' ');
+            s.write_number(protocol[p].second);
+            s.put('\n');
+        }
         if(maxTime>0) {
-            s << "#" << maxTime << " " << -1 << std::endl;
+            s.put('#');
+            s.write_number(maxTime);
+            s.write(" -1\n");
         }
         
+        const auto write_row = [&s] (const char* prefix, const auto& A, const int& row, const int& cols) {
+            s.write(prefix);
+            for(int j=0; j<cols; ++j) {
+                s.put(' ');
+                s.write_number(double(A(row,j)));
+            }
+            s.put('\n');
+        };
+        const auto write_index = [&s] (const auto& i) {
+            s.write_number((long long)i+1);
+        };
+        
         for(int v=0; v<V.rows(); ++v)
-            s << "v " << V(v,0) << " " << V(v,1) << " " << V(v,2) << std::endl;
+            write_row("v", V, v, 3);
         
         for(int v=0; v<flatV.rows(); ++v)
-            s << "vt " << flatV(v,0) << " " << flatV(v,1) << std::endl;
+            write_row("vt", flatV, v, 2);
         
-        if(origF.rows()>0 && origF==F) {
-            //Do we also print an original mesh?
+        const bool hasOrig = origF.rows()>0 && origF==F;
+        //Do we also print an original mesh?
+        if(hasOrig)
             for(int v=0; v<V.rows(); ++v)
-                s << "vo " << origV(v,0) << " " << origV(v,1) << " " << origV(v,2) << std::endl;
-            for(int f=0; f<F.rows(); ++f)
-                s << "f " << F(f,0)+1 << "/" << flatF(f,0)+1 << "/" << origF(f,0)+1 << " " << F(f,1)+1 << "/" << flatF(f,1)+1 << "/" << origF(f,1)+1 << " " << F(f,2)+1 << "/" << flatF(f,2)+1 << "/" << origF(f,2)+1 << std::endl;
-        } else {
-            for(int f=0; f<F.rows(); ++f)
-                s << "f " << F(f,0)+1 << "/" << flatF(f,0)+1 << " " << F(f,1)+1 << "/" << flatF(f,1)+1 << " " << F(f,2)+1 << "/" << flatF(f,2)+1 << std::endl;
+                write_row("vo", origV, v, 3);
+        for(int f=0; f<F.rows(); ++f) {
+            s.put('f');
+            for(int j=0; j<3; ++j) {
+                s.put(' ');
+                write_index(F(f,j));
+                s.put('/');
+                write_index(flatF(f,j));
+                if(hasOrig) {
+                    s.put('/');
+                    write_index(origF(f,j));
+                }
+            }
+            s.put('\n');
         }
+        
+        success = s.close() && success;
     }
     
+    return success;
 }
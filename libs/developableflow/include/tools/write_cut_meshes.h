@@ -31,8 +31,11 @@
 #include <string>
 
 
+//Files ending in .ply are written as binary little-endian PLY, all others as OBJ. Output 2 as PLY holds the mesh
+//with the flattened coordinates as per-corner texture coords, without the protocol and the original mesh.
+//Returns false if a file could not be written.
 template <typename derivedV, typename derivedF, typename derivedFlatV, typename derivedFlatF>
-IGL_INLINE void write_cut_meshes(
+IGL_INLINE bool write_cut_meshes(
                                  const Eigen::PlainObjectBase<derivedV>& V, //Vertices
                                  const Eigen::PlainObjectBase<derivedF>& F, //Faces
                                  const Eigen::PlainObjectBase<derivedFlatV>& flatV, //Flattened vertices
@@ -43,7 +46,7 @@ IGL_INLINE void write_cut_meshes(
                                  const int& maxTime = 0); //The current timestep number
 
 template <typename derivedV, typename derivedF, typename derivedFlatV, typename derivedFlatF, typename derivedOrigV, typename derivedOrigF>
-IGL_INLINE void write_cut_meshes(
+IGL_INLINE bool write_cut_meshes(
                                  const Eigen::PlainObjectBase<derivedV>& V, //Vertices
                                  const Eigen::PlainObjectBase<derivedF>& F, //Faces
                                  const Eigen::PlainObjectBase<derivedFlatV>& flatV, //Flattened vertices
@@ -24,89 +24,121 @@
 #include "write_energy.h"
 
 #include <developableflow/energy_selector.h>
+#include <tools/mesh_writer.h>
+#include <tools/thread_pool.h>
 
-#ifdef REQUIRE_MATLAB
-#include <igl/matlab/MatlabWorkspace.h>
-#endif
-
-#include <limits>
-#include <deque>
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
 
 #include <Eigen/Core>
 
 
-template <typename derivedV, typename derivedF, typename indexType, typename derivedP, typename t_res>
-IGL_INLINE void write_energy(
+template <typename derivedV, typename derivedF, typename indexType, typename cornerType, typename derivedP, typename t_res>
+IGL_INLINE bool write_energy(
                              const Eigen::PlainObjectBase<derivedV>& V,
                              const Eigen::PlainObjectBase<derivedF>& F,
                              const std::vector<std::vector<indexType> >& VF,
-                             const std::vector<std::vector<indexType> >& VFi,
+                             const std::vector<std::vector<cornerType> >& VFi,
                              const std::vector<bool>& isB,
                              const Eigen::PlainObjectBase<derivedP>& p,
                              const std::string& filename,
                              const t_res& resolution,
-                             EnergyType energyType)
+                             EnergyType energyType,
+                             const int& nSamples,
+                             const bool& withGradient,
+                             const bool& perVertex)
 {
     typedef typename derivedV::Scalar t_V_s;
-    typedef Eigen::Matrix<t_V_s, Eigen::Dynamic, 3> t_V;
-    typedef Eigen::Matrix<t_V_s, Eigen::Dynamic, Eigen::Dynamic> t_Vdyn;
+    typedef Eigen::Matrix<t_V_s, Eigen::Dynamic, 3, (derivedV::IsRowMajor ? Eigen::RowMajor : Eigen::ColMajor)> t_V;
     typedef Eigen::Matrix<t_V_s, Eigen::Dynamic, 1> t_Vv;
-    typedef Eigen::Matrix<t_V_s, 1, 3> t_V3;
-    typedef typename derivedF::Scalar t_F_i;
-    typedef Eigen::Matrix<t_F_i, Eigen::Dynamic, 3> t_F;
-    typedef typename derivedP::Scalar t_p_s;
-    typedef Eigen::Matrix<t_p_s, Eigen::Dynamic, 3> t_p;
-    
+
     assert(p.rows() == V.rows() && "The search direction must be a valid step direction for your current mesh.");
-    
-#ifdef REQUIRE_MATLAB
-    int nSamples = 10000;
-    
-    t_Vv alphas(nSamples);
-    t_Vv energies(nSamples);
-    t_Vv energyGrads(nSamples);
-    t_Vv energyGradDotPs(nSamples);
-    
-    t_Vdyn energiesPerVert(nSamples, V.rows());
-    t_Vdyn energyGradsPerVert(nSamples, 3*V.rows());
-    t_Vdyn smallestEigenvecPerVert(nSamples, 3*V.rows());
-    
-    for(int i=0; i<nSamples; ++i) {
-        t_V_s alpha = resolution*(i-0.5*nSamples);
-        t_Vv en;
-        t_V egrad;
-        
-        t_V newV = V + alpha*p;
-        
-        energy_selector(energyType, newV, F, VF, VFi, isB, en, egrad);
-        
-        alphas(i) = alpha;
-        energies(i) = en.sum();
-        energyGrads(i) = egrad.norm() / sqrt((t_V_s) egrad.rows());
-        energyGradDotPs(i) = (egrad.array()*p.array()).sum();
-        
-        energiesPerVert.row(i) = en;
-        t_Vv reshapedGrads = Eigen::Map<t_Vv>(egrad.data(), egrad.size());
-        energyGradsPerVert.row(i) = reshapedGrads;
-        
-        t_V minCurvatureVecs;
-        hinge_energy(newV, F, VF, VFi, isB, en, minCurvatureVecs);
-        t_Vv reshapedCurvs = Eigen::Map<t_Vv>(minCurvatureVecs.data(), minCurvatureVecs.size());
-        smallestEigenvecPerVert.row(i) = reshapedCurvs;
+
+    const bool csv = filename.size()>=4 && filename.compare(filename.size()-4, 4, ".csv")==0;
+    const int nV = V.rows();
+    const int nColumns = withGradient ? 4 : 2;
+
+    BufferedWriter s;
+    if(!s.open(filename))
+        return false;
+
+    if(csv) {
+        s.write(withGradient ? "alpha,energy,energyGrad,energyGradDotP\n" : "alpha,energy\n");
+    } else {
+        s.write("DENERGY", 8);
+        s.write_binary(std::uint32_t(WRITE_ENERGY_VERSION));
+        s.write_binary(std::uint32_t((withGradient ? 1 : 0) | (perVertex ? 2 : 0)));
+        s.write_binary(std::uint64_t(nSamples));
+        s.write_binary(std::uint64_t(nV));
     }
-    
-    igl::matlab::MatlabWorkspace mw;
-    mw.save(alphas, "alphas");
-    mw.save(energies, "energies");
-    mw.save(energyGrads, "energyGrads");
-    mw.save(energyGradDotPs, "energyGradDotPs");
-    mw.save(energiesPerVert, "energiesPerVert");
-    mw.save(energyGradsPerVert, "energyGradsPerVert");
-    mw.save(smallestEigenvecPerVert, "smallestEigenvecPerVert");
-    mw.save(doublecast(V), "V");
-    mw.save_index(intcast(F), "F");
-    mw.write(filename);
+
+    //Per-thread scratch, and the results of one chunk of samples
+    struct Scratch {
+        t_V newV, egrad;
+        t_Vv en;
+    };
+    std::vector<Scratch> scratch;
+    std::vector<double> columns(WRITE_ENERGY_CHUNK*nColumns);
+    std::vector<double> perVertexEnergies(perVertex ? WRITE_ENERGY_CHUNK*nV : 0);
+
+    for(int chunkBegin=0; chunkBegin<nSamples; chunkBegin+=WRITE_ENERGY_CHUNK) {
+        const int chunkSize = std::min(WRITE_ENERGY_CHUNK, nSamples-chunkBegin);
+
+        const auto prep_scratch = [&scratch] (const int& nThreads) {
+            scratch.resize(std::max<size_t>(scratch.size(), nThreads));
+        };
+        const auto handle_sample = [&] (const int& i, const int& thread) {
+            Scratch& sc = scratch[thread];
+            const t_V_s alpha = resolution*(chunkBegin+i-0.5*nSamples);
+            sc.newV = V + alpha*p;
+
+            double* row = columns.data() + nColumns*i;
+            row[0] = alpha;
+            if(withGradient) {
+                energy_selector(energyType, sc.newV, F, VF, VFi, isB, sc.en, sc.egrad);
+                row[2] = sc.egrad.norm() / sqrt((t_V_s) sc.egrad.rows());
+                row[3] = (sc.egrad.array()*p.array()).sum();
+            } else {
+                energy_selector(energyType, sc.newV, F, VF, VFi, isB, sc.en);
+            }
+            row[1] = sc.en.sum();
+
+            if(perVertex)
+                for(int v=0; v<nV; ++v)
+                    perVertexEnergies[size_t(i)*nV + v] = sc.en(v);
+        };
+
+#ifndef PARALLEL_COMPUTATION
+        //SERIAL VERSION
+        prep_scratch(1);
+        for(int i=0; i<chunkSize; ++i)
+            handle_sample(i, 0);
 #else
-    std::cerr << "Please enable MATLAB for this feature." << std::endl;
+        //PARALLEL VERSION
+        solver_parallel_for(chunkSize, prep_scratch, handle_sample, [] (const int&) {}, 1);
 #endif
+
+        //Stream the chunk out
+        for(int i=0; i<chunkSize; ++i) {
+            const double* row = columns.data() + nColumns*i;
+            if(csv) {
+                for(int c=0; c<nColumns; ++c) {
+                    if(c > 0)
+                        s.put(',');
+                    s.write_number(row[c]);
+                }
+                s.put('\n');
+            } else {
+                for(int c=0; c<nColumns; ++c)
+                    s.write_binary(row[c]);
+                if(perVertex)
+                    for(int v=0; v<nV; ++v)
+                        s.write_binary(perVertexEnergies[size_t(i)*nV + v]);
+            }
+        }
+    }
+
+    return s.close();
 }
@@ -26,22 +26,40 @@
 
 #include <igl/igl_inline.h>
 
+#include <developableflow/energy_selector.h>
+
 #include <Eigen/Core>
 #include <vector>
 #include <string>
 
 
-template <typename derivedV, typename derivedF, typename indexType, typename derivedP, typename t_res>
-IGL_INLINE void write_energy(
+//Default number of step sizes sampled along p
+#define WRITE_ENERGY_SAMPLES 10000
+//Samples evaluated in parallel and then written before the next chunk starts, this bounds the memory
+#define WRITE_ENERGY_CHUNK 256
+#define WRITE_ENERGY_VERSION 1
+
+
+//Sample the energy along the line V + alpha*p, alpha = resolution*(i - nSamples/2), to see why a line search failed.
+//The samples of a chunk are evaluated in parallel and streamed to the file, nothing is held for all samples at once.
+//Files ending in .csv get one line per sample: alpha,energy[,energyGrad,energyGradDotP] (energyGrad is the scaled L2 norm).
+//All other files are binary little endian: "DENERGY\0", uint32 version, uint32 flags (1 gradient, 2 per-vertex), uint64 nSamples,
+//uint64 nV, then per sample the doubles alpha, energy[, energyGrad, energyGradDotP][, nV per-vertex energies].
+//Returns false if the file could not be written.
+template <typename derivedV, typename derivedF, typename indexType, typename cornerType, typename derivedP, typename t_res>
+IGL_INLINE bool write_energy(
                             const Eigen::PlainObjectBase<derivedV>& V, //Vertices
                             const Eigen::PlainObjectBase<derivedF>& F, //Faces
                             const std::vector<std::vector<indexType> >& VF, //VF from vertex-triangle adjacency
-                            const std::vector<std::vector<indexType> >& VFi, //VFi from vertex-triangle adjacency
+                            const std::vector<std::vector<cornerType> >& VFi, //VFi from vertex-triangle adjacency
                             const std::vector<bool>& isB, //isB from is_border_vertex
                             const Eigen::PlainObjectBase<derivedP>& p, //direction along which energy will be sampled
                             const std::string& filename, //file to write the energy values to
                             const t_res& resolution = 1e-7, //resolution of the energy writing
-                            EnergyType energyType = ENERGY_TYPE_HINGE);//Which energy to use for the step: 0 normal, 1 midWidth (according to order in this file)
+                            EnergyType energyType = ENERGY_TYPE_HINGE, //Which energy to use for the step: 0 normal, 1 midWidth (according to order in this file)
+                            const int& nSamples = WRITE_ENERGY_SAMPLES, //Number of step sizes
+                            const bool& withGradient = true, //Also write the gradient columns, false uses the cheaper energy-only evaluation
+                            const bool& perVertex = false); //Also write the per-vertex energies (binary files only)
 
 
 
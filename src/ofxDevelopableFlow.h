@@ -6,14 +6,22 @@
 #include "ofxDevelopableTypes.h"
 #include <developableflow/compute_cut.h>
 #include <developableflow/curvature_energy.h>
+#include <developableflow/cut_graph.h>
+#include <developableflow/cut_wedges.h>
 #include <developableflow/energy_selector.h>
 #include <developableflow/exactfcts_bisectors.h>
+#include <developableflow/flatten_charts.h>
 #include <developableflow/flatten_cut.h>
 #include <developableflow/hinge_energy.h>
 #include <developableflow/hingepairs_energy.h>
+#include <developableflow/incremental_cut.h>
+#include <developableflow/isotropic_remeshing.h>
 #include <developableflow/max_hinge_energy.h>
 #include <developableflow/measure_once_cut_twice.h>
 #include <developableflow/mesh_postprocessing.h>
+#include <developableflow/native_parameterization.h>
+#include <developableflow/scp_solver.h>
+#include <developableflow/select_punctures.h>
 //#include <developableflow/old_hinge_energy.h>
 //#include <developableflow/old_max_hinge_energy.h>
 #include <developableflow/timestep.h>
@@ -26,6 +34,15 @@
 #include <tools/write_cut_meshes.h>
 #include <tools/numerical_gradient.h>
 #include <tools/perturb.h>
+#include <tools/thread_pool.h>
+#include <tools/distortion_metrics.h>
+#include <tools/pack_charts.h>
+#include <tools/mapped_file.h>
+#include <tools/read_obj_mapped.h>
+#include <tools/dmesh_io.h>
+#include <tools/mesh_writer.h>
+#include <tools/trajectory.h>
+#include <tools/async_exporter.h>
 
 //
 //#include <viewer/OViewer.h>
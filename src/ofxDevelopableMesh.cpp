@@ -13,9 +13,9 @@ ofxDevelopableMesh::ofxDevelopableMesh(const OMatrixXs& iV, const OMatrixXi& iF)
     //typedef Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic> OMatrixXs;
     //  OMatrixXs V;
     V = iV;
-    F = iF;
+    F = iF.cast<OIndex>();
     origV = iV;
-    origF = iF;
+    origF = F;
     update();
 }
 ofxDevelopableMesh::ofxDevelopableMesh(const char *fileName){
@@ -36,8 +36,8 @@ void ofxDevelopableMesh::update()
         if(isB[i])
             continue;
         
-        std::vector<typename OMatrixXi::Scalar>& newVF = VF[i];
-        std::vector<typename OMatrixXi::Scalar>& newVFi = VFi[i];
+        std::vector<OIndex>& newVF = VF[i];
+        std::vector<OCornerIndex>& newVFi = VFi[i];
         
         //We keep the first face intact, then we rotate over the others
         for(int ind=1; ind < newVF.size(); ++ind) {
@@ -60,6 +60,32 @@ void ofxDevelopableMesh::update()
     //        isB[i]=true;
     //}
 }
+void ofxDevelopableMesh::updateMesh()
+{
+    //Fill the vertex and index buffers of the ofMesh in one go from V and F
+    mesh.clear();
+    mesh.setMode(OF_PRIMITIVE_TRIANGLES);
+    std::vector<glm::vec3>& vertices = mesh.getVertices();
+    vertices.resize(V.rows());
+    Eigen::Map<Eigen::Matrix<float, Eigen::Dynamic, 3, Eigen::RowMajor> >(reinterpret_cast<float*>(vertices.data()), V.rows(), 3) = V.cast<float>();
+    std::vector<ofIndexType>& indices = mesh.getIndices();
+    indices.resize(3*F.rows());
+    Eigen::Map<Eigen::Matrix<ofIndexType, Eigen::Dynamic, 3, Eigen::RowMajor> >(indices.data(), F.rows(), 3) = F.cast<ofIndexType>();
+    m_mesh = mesh;
+}
+int ofxDevelopableMesh::remesh(double targetEdgeLength, int nIterations)
+{
+    //origV follows the remeshed vertices, so the new mesh is also the new original connectivity
+    int change = isotropic_remeshing(V, F, origV, targetEdgeLength, nIterations);
+    if(change==1) {
+        origF = F;
+        update();
+    }
+    //The vertices move even without a change to F
+    updateMesh();
+    return change;
+}
+
 void ofxDevelopableMesh::draw(ofPolyRenderMode renderType){
     switch(renderType){
         case OF_MESH_POINTS:
@@ -85,39 +111,28 @@ void ofxDevelopableMesh::drawFaces(){
     mesh.setMode(OF_PRIMITIVE_TRIANGLES);
     mesh.draw(OF_MESH_FILL);
 }
-void ofxDevelopableMesh::save(){
+bool ofxDevelopableMesh::save(const string& name, const bool& wait){
     ofxDevelopableReader reader;
-    reader.exportOBJ(mesh, "hey.obj");
- 
+    return reader.exportOBJ(mesh, name, wait);
 }
 
 
 void ofxDevelopableMesh::loadModel(const char *fileName){
-    ofxDevelopableReader reader;
-    mesh.setMode(OF_PRIMITIVE_TRIANGLES);
     string modelpath = ofToDataPath(fileName);
-    igl::read_triangle_mesh(modelpath,V,F);
-    igl::read_triangle_mesh(modelpath,tempV,tempF);
-
-    for(auto & v : tempV){
-        for (int i=0; i<1; i++){
-            ofVec3f temp(v.at(i),v.at(i+1),v.at(i+2));
-            mesh.addVertex(glm::vec3(v.at(i),v.at(i+1),v.at(i+2)));
-            m_mesh.addVertex(glm::vec3(v.at(i),v.at(i+1),v.at(i+2)));
- 
-        }
-    }
-    for(auto & v : tempF){
-        for (int i=0; i<1; i++){
-            ofVec3f temp(v.at(i),v.at(i+1),v.at(i+2));
-            mesh.addIndex(v.at(i));
-            mesh.addIndex(v.at(i+1));
-            mesh.addIndex(v.at(i+2));
-            m_mesh.addIndex(v.at(i));
-            m_mesh.addIndex(v.at(i+1));
-            m_mesh.addIndex(v.at(i+2));
-        }
+    
+    //A mesh that was loaded before comes with its adjacency from the .dmesh cache, the hash catches edited files
+    string cachepath = ofFilePath::removeExt(modelpath) + ".dmesh";
+    std::uint64_t sourceHash = 0;
+    bool hashed = dmesh_file_hash(modelpath, sourceHash);
+    bool cached = hashed && read_dmesh(cachepath, sourceHash, V, F, E, edgesC, TT, TTi, VF, VFi, isB);
+    if(!cached){
+        //One parse straight into V and F, libigl handles the other formats
+        if(ofToLower(ofFilePath::getFileExt(modelpath)) != "obj" || !read_obj_mapped(modelpath,V,F))
+            igl::read_triangle_mesh(modelpath,V,F);
     }
+    
+    updateMesh();
+    
     //same as constructor
     origV = V;
     origF = F;
@@ -130,7 +145,11 @@ void ofxDevelopableMesh::loadModel(const char *fileName){
 //    m_origF = F;
    
     
-    update();
+    if(!cached){
+        update();
+        if(hashed && !write_dmesh(cachepath, sourceHash, V, F, E, edgesC, TT, TTi, VF, VFi, isB))
+            ofLogWarning("ofxDevelopableMesh") << "could not write " << cachepath;
+    }
 }
 
 
@@ -19,35 +19,39 @@
 #include <igl/vertex_triangle_adjacency.h>
 #include <igl/unique_simplices.h>
 #include <igl/is_border_vertex.h>
+#include <developableflow/isotropic_remeshing.h>
+#include <tools/dmesh_io.h>
+#include <tools/read_obj_mapped.h>
+#include <tools/async_exporter.h>
 #include "ofxDevelopableReader.h"
 
 class ofxDevelopableMesh{
 public:
     ofMesh mesh;
-    OMatrixXs origV;
-    OMatrixXi origF;
-    OMatrixXs V;
-    OMatrixXi F;
-    std::vector<std::vector<float> > tempV;
-    std::vector<std::vector<float> > tempF;
-    OMatrixXi allE;
-    OMatrixXi E;
-    OMatrixXi edgesA;
-    OMatrixXi edgesC;
-    OMatrixXi TT; //triangle-triangle adjacency
-    OMatrixXi TTi; //triangle-triangle adjacencyi
-    std::vector<std::vector<typename OMatrixXi::Scalar> > VF; //vertex-triangle adjacency
-    std::vector<std::vector<typename OMatrixXi::Scalar> > VFi; //vertex-triangle adjacencyi
+    OMatrixX3s origV;
+    OMatrixX3i origF;
+    OMatrixX3s V;
+    OMatrixX3i F;
+    OMatrixX2i allE;
+    OMatrixX2i E;
+    OVectorXidx edgesA;
+    OVectorXidx edgesC;
+    OMatrixX3i TT; //triangle-triangle adjacency
+    OMatrixX3c TTi; //triangle-triangle adjacencyi
+    std::vector<std::vector<OIndex> > VF; //vertex-triangle adjacency
+    std::vector<std::vector<OCornerIndex> > VFi; //vertex-triangle adjacencyi
     std::vector<bool> isB; //is border vertex
     ofxDevelopableMesh();
     ofxDevelopableMesh(const OMatrixXs& iV, const OMatrixXi& iF);
     ofxDevelopableMesh(const char *fileName);
     void update();
+    void updateMesh(); //copy V and F to the ofMesh buffers
+    int remesh(double targetEdgeLength = 0, int nIterations = 1); //isotropic remeshing, call every few flow steps
     
     void draw(ofPolyRenderMode renderType);
     void drawWireframe();
     void drawFaces();
-    void save();
+    bool save(const string& name = "hey.obj", const bool& wait = false); //OBJ, or binary PLY for .ply, written in the background unless wait. False if a write failed
     
     //using reader
     void loadModel(const char *fileName);
@@ -7,6 +7,10 @@
 
 #include "ofxDevelopableReader.h"
 
+#include <tools/read_obj_mapped.h>
+#include <tools/mesh_writer.h>
+#include <tools/async_exporter.h>
+
 
 ofxDevelopableReader::ofxDevelopableReader()
 {
@@ -23,7 +27,7 @@ void ofxDevelopableReader::loadFile(const char *fileName)
     if (materialBool == true)
     {
         ifstream matFile;
-        char matLine[255];
+        string matLine;
         
         char materialFile[255];
         strncpy(materialFile, fileName, sizeof(materialFile));
@@ -34,9 +38,9 @@ void ofxDevelopableReader::loadFile(const char *fileName)
         
         if (matFile.is_open())
         {
-            while (matFile.getline(matLine, 255))
+            while (getline(matFile, matLine))
             {
-                parseMaterial(matLine);
+                parseMaterial(&matLine[0]);
             }
         }
         
@@ -46,7 +50,7 @@ void ofxDevelopableReader::loadFile(const char *fileName)
     
     //get filename and open corresponding .obj file
     ifstream objFile;
-    char line[255];
+    string line;
     
     char objectFile[256];
     strncpy(objectFile, fileName, sizeof(objectFile));
@@ -57,9 +61,9 @@ void ofxDevelopableReader::loadFile(const char *fileName)
     
     if (objFile.is_open())
     {
-        while (objFile.getline(line,256))
+        while (getline(objFile, line))
         {
-            parseLine(line);
+            parseLine(&line[0]);
         }
     }
     
@@ -243,31 +247,18 @@ ofMesh ofxDevelopableReader::generateMesh()
 }
 ofMesh ofxDevelopableReader::generateMesh(const OMatrixXs& iV, const OMatrixXi& iF)
 {
-    vector<ofVec3f> vrtx;
-//    igl::matrix_to_list(iV, vrtx);
-
-    int materialCount = materialColors.size();
-    int localIndexCount = 0;
+    ofMesh m;
+    m.setMode(OF_PRIMITIVE_TRIANGLES);
     
-    ofColor vertColor;
-    ofColor defaultColor = ofColor(0.0, 255.0, 0.0);
+    vector<glm::vec3>& vrtx = m.getVertices();
+    vrtx.resize(iV.rows());
+    Eigen::Map<Eigen::Matrix<float, Eigen::Dynamic, 3, Eigen::RowMajor> >(reinterpret_cast<float*>(vrtx.data()), iV.rows(), 3) = iV.leftCols(3).cast<float>();
     
-    for (std::vector<Index>::iterator i = indices.begin(); i != indices.end(); ++i)
-    {
-        if (materialLocations[localIndexCount] != "")
-        {
-            vertColor = mapColor(materialColors[materialLocations[localIndexCount]].diffuseColor);
-        }
-        
-        //draw triangles
-        addFace(&vertices[(i->v1) - 1], &normals[(i->vn1) - 1], &vertColor);
-        addFace(&vertices[(i->v2) - 1], &normals[(i->vn2) - 1], &vertColor);
-        addFace(&vertices[(i->v3) - 1], &normals[(i->vn3) - 1], &vertColor);
-        
-        localIndexCount++;
-    }
+    vector<ofIndexType>& idx = m.getIndices();
+    idx.resize(3*iF.rows());
+    Eigen::Map<Eigen::Matrix<ofIndexType, Eigen::Dynamic, 3, Eigen::RowMajor> >(idx.data(), iF.rows(), 3) = iF.leftCols(3).cast<ofIndexType>();
     
-    return mesh;
+    return m;
 }
 
 void ofxDevelopableReader::addFace(ofVec3f *vertex, ofVec3f *normal, ofColor *color)
@@ -337,62 +328,34 @@ ofColor ofxDevelopableReader::mapColor(colorRGB vertexColor)
 }
 
 bool ofxDevelopableReader::loadModel(const char *fileName, OMatrixXs &V, OMatrixXi &F){
-    ofxDevelopableReader reader;
-    mesh.setMode(OF_PRIMITIVE_TRIANGLES);
-    reader.loadFile(fileName);
-    mesh = reader.generateMesh();
-    //then get V and F and stick it back to the class
-    
-    const int m = mesh.getVertices().size();
-    OMatrixXs vecs;
-    // number of columns
-    const int n = 3;
-    std::cout << m << std::endl;
-    std::cout << n << std::endl;
-    //    vecs.resize(m,n);
-    // Loop over rows
-    for(int i = 0;i<m;i++)
-    {
-        // Loop over cols
-        for(int j = 0;j<n;j++)
-        {
-            vecs(i,j) = mesh.getVertices()[i][j];
-            
-        }
+    //Memory mapped parallel parse straight into V and F
+    if(!read_obj_mapped(ofToDataPath(fileName), V, F)){
+        ofLogError("ofxDevelopableReader") << "could not load " << fileName;
+        return false;
     }
-    
-    V = vecs;
-    
-        const int j = mesh.getIndices().size();
-        OMatrixXi faces;
-        //number of columns;
-        const int k = 3;
-    //    faces.resize(j,k);
-        for(int x=0;x<j;x++){
-            for(int y=0;y<k;y++){
-                int tempx = mesh.getIndex(x);
-                int tempy = mesh.getIndex(y);
-                faces(tempx,tempy);
-            }
-        }
-        F = faces;
+    mesh = generateMesh(V, F);
     return true;
 }
 
-void ofxDevelopableReader::exportOBJ(ofMesh m,const string name){
-    ofFile obj;
-    obj.open(ofToDataPath(name),ofFile::WriteOnly);
-    obj << "#vertices:\n";
-    for(int i = 0 ; i < m.getNumVertices(); i++) {
-        ofVec3f v = m.getVertex(i);
-        obj << "v " + ofToString(v.x) + " " + ofToString(v.y) + " " + ofToString(v.z) + "\n";
-    }
-    obj << "#faces:\n";
-    for(int i = 0 ; i < m.getNumIndices(); i += 3)
-        obj << "f " + ofToString(m.getIndex(i)+1) + " " + ofToString(m.getIndex(i+1)+1) + " " + ofToString(m.getIndex(i+2)+1) + "\n";
-    obj << "\n";
-    obj.close();
-    cout << "wrote " << name << endl;
+size_t ofxDevelopableReader::reportedExportFailures = 0;
+
+bool ofxDevelopableReader::exportOBJ(const ofMesh& m,const string name, const bool& wait){
+    //Snapshot the ofMesh buffers now, the file is written on the export thread
+    const vector<glm::vec3>& vertices = m.getVertices();
+    const vector<ofIndexType>& idx = m.getIndices();
+    ExportMatrix V = export_snapshot(Eigen::Map<const Eigen::Matrix<float, Eigen::Dynamic, 3, Eigen::RowMajor> >(reinterpret_cast<const float*>(vertices.data()), vertices.size(), 3));
+    ExportIndices F = export_snapshot_indices(Eigen::Map<const Eigen::Matrix<ofIndexType, Eigen::Dynamic, 3, Eigen::RowMajor> >(idx.data(), idx.size()/3, 3));
+    async_exporter().export_mesh(ofToDataPath(name), V, F);
+    if(wait)
+        async_exporter().flush();
+    
+    //The writes run on the export thread, so their errors only show up in the failure count
+    const size_t nFailures = async_exporter().failures();
+    if(nFailures == reportedExportFailures)
+        return true;
+    ofLogError("ofxDevelopableReader") << nFailures-reportedExportFailures << " background export(s) failed, last queued " << name;
+    reportedExportFailures = nFailures;
+    return false;
 }
 
 ofxDevelopableReader::~ofxDevelopableReader()
@@ -87,10 +87,13 @@ public:
     //adding model
     
     bool loadModel(const char *fileName, OMatrixXs &V, OMatrixXi &F);
-    void exportOBJ(ofMesh m,const string name);
+    //OBJ, or binary PLY for .ply, written in the background by async_exporter(). Logs the background writes that failed
+    //since the last call, with wait also this one. Returns false if any did.
+    bool exportOBJ(const ofMesh& m,const string name, const bool& wait = false);
 //    OMatrixXs V;
 //    OMatrixXi F;
     private:
+    static size_t reportedExportFailures; //async_exporter().failures() already logged
 };
 
 
@@ -10,6 +10,7 @@
 #pragma once
 //#include <Eigen/Core>
 #include "ofxEigen.h"
+#include <cstdint>
 
 
 //YOU NEED TO ENABLE CGAL IN THE CMAKELISTS.TXT FOR ANYTHING BUT THE BASIC TYPES TO WORK
@@ -21,6 +22,27 @@
 #define SCALAR_TYPE DOUBLE
 #define MPFR_PRECISION 256 //128
 
+//Storage of the per-mesh matrices (V, F, E, TT, TTi, ...)
+//ROWMAJOR_STORAGE fixes the column count and keeps each vertex/face contiguous in memory,
+//DYNAMIC_STORAGE is the old fully dynamic column-major layout
+#define DYNAMIC_STORAGE 1
+#define ROWMAJOR_STORAGE 2
+#define MESH_STORAGE ROWMAJOR_STORAGE
+
+//Width of the vertex/face/edge indices, INDEX_64 is only needed past 2^31 faces or corners
+#define INDEX_32 1
+#define INDEX_64 2
+#define INDEX_WIDTH INDEX_32
+
+//Mesh indices
+#if INDEX_WIDTH == INDEX_64
+typedef std::int64_t OIndex;
+#else
+typedef std::int32_t OIndex;
+#endif
+//Corner indices (VFi, TTi) only ever hold -1..2
+typedef std::int8_t OCornerIndex;
+
 //Standard fixed-precision integers
 typedef Eigen::Matrix<int, Eigen::Dynamic, Eigen::Dynamic> OMatrixXi;
 typedef Eigen::Matrix<int, 3, 3> OMatrix3i;
@@ -28,10 +50,21 @@ typedef Eigen::Matrix<int, Eigen::Dynamic, 1> OVectorXi;
 typedef Eigen::Matrix<int, 3, 1> OVector3i;
 typedef Eigen::Matrix<int, 1, Eigen::Dynamic> ORowVectorXi;
 typedef Eigen::Matrix<int, 1, 3> ORowVector3i;
-
-static Eigen::MatrixXi intcast(const OMatrixXi& A)
+typedef Eigen::Matrix<OIndex, Eigen::Dynamic, 1> OVectorXidx;
+#if MESH_STORAGE == ROWMAJOR_STORAGE
+typedef Eigen::Matrix<OIndex, Eigen::Dynamic, 3, Eigen::RowMajor> OMatrixX3i;
+typedef Eigen::Matrix<OIndex, Eigen::Dynamic, 2, Eigen::RowMajor> OMatrixX2i;
+typedef Eigen::Matrix<OCornerIndex, Eigen::Dynamic, 3, Eigen::RowMajor> OMatrixX3c;
+#else
+typedef Eigen::Matrix<OIndex, Eigen::Dynamic, Eigen::Dynamic> OMatrixX3i;
+typedef Eigen::Matrix<OIndex, Eigen::Dynamic, Eigen::Dynamic> OMatrixX2i;
+typedef Eigen::Matrix<OCornerIndex, Eigen::Dynamic, Eigen::Dynamic> OMatrixX3c;
+#endif
+
+template <typename derived>
+static Eigen::MatrixXi intcast(const Eigen::PlainObjectBase<derived>& A)
 {
-    return A;
+    return A.template cast<int>();
 }
 
 
@@ -45,6 +78,11 @@ typedef Eigen::Matrix<double, Eigen::Dynamic, 1> OVectorXs;
 typedef Eigen::Matrix<double, 3, 1> OVector3s;
 typedef Eigen::Matrix<double, 1, Eigen::Dynamic> ORowVectorXs;
 typedef Eigen::Matrix<double, 1, 3> ORowVector3s;
+#if MESH_STORAGE == ROWMAJOR_STORAGE
+typedef Eigen::Matrix<double, Eigen::Dynamic, 3, Eigen::RowMajor> OMatrixX3s;
+#else
+typedef OMatrixXs OMatrixX3s;
+#endif
 
 
 void types_startup()